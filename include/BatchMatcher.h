@@ -0,0 +1,41 @@
+#ifndef BATCHMATCHER_H_
+#define BATCHMATCHER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "DFA.h"
+
+namespace Automata {
+
+// Matches many strings against one DenseDFA. Walking a single string is a chain of
+// dependent table loads; here Lanes strings advance side by side, one byte each per
+// round, so their loads overlap, and the bytes of upcoming inputs are prefetched. A lane
+// that finishes its string takes the next one. Bit i % 64 of word i / 64 tells whether
+// input i is accepted.
+class BatchMatcher
+{
+public:
+	using IndexType = DenseDFA::IndexType;
+	static constexpr size_t Lanes = 16;
+
+protected:
+	const DenseDFA& _dfa;
+
+public:
+	BatchMatcher(const DenseDFA&);
+	// Only a reference to the DFA is kept, so it can not be a temporary
+	BatchMatcher(DenseDFA&&) = delete;
+	void run(const std::string*, size_t, std::uint64_t*) const;
+	std::vector<std::uint64_t> run(const std::vector<std::string>&) const;
+	static bool isAccepted(const std::vector<std::uint64_t>& accepted, const size_t& input)
+	{
+		return (accepted[input / 64] >> (input % 64)) & 1;
+	}
+};
+
+} /* namespace Automata */
+
+#endif /* BATCHMATCHER_H_ */
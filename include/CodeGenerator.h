@@ -0,0 +1,42 @@
+#ifndef CODEGENERATOR_H_
+#define CODEGENERATOR_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DFA.h"
+
+namespace Automata {
+
+// Emits self-contained C++ matchers for dense DFAs, bool name(const char*, std::size_t)
+// in the source plus a std::string_view overload in the header. Switch style turns every state into a
+// label and a switch over the next byte, table style into static const tables walked by a
+// loop with the narrowest state type that fits. Both return false as soon as the dead
+// state is reached.
+class CodeGenerator
+{
+public:
+	enum class Style { Switch, Table };
+	struct Matcher
+	{
+		std::string name;
+		std::string regex;
+		DenseDFA dfa;
+	};
+
+	CodeGenerator() = delete;
+	static void emitHeader(const std::vector<Matcher>&, std::ostream&);
+	static void emitSource(const std::vector<Matcher>&, const Style&, std::ostream&);
+
+private:
+	static void checkName(const std::string&);
+	static std::string quote(const std::string&);
+	static void emitSwitch(const DenseDFA&, std::ostream&);
+	static void emitTable(const DenseDFA&, std::ostream&);
+	static std::string byteLiteral(const unsigned char&);
+};
+
+} /* namespace Automata */
+
+#endif /* CODEGENERATOR_H_ */
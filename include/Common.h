@@ -5,6 +5,7 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 namespace Automata
 {
@@ -13,8 +14,14 @@ namespace Automata
 	using SymbolType = std::string;
 	using SymbolSetType = std::set<SymbolType>;
 	using AlphabetType = SymbolSetType;
+	using SymbolIdType = unsigned int;
+	// Ids of the patterns a state accepts for, kept sorted
+	using PatternIdType = unsigned int;
+	using PatternSetType = std::vector<PatternIdType>;
 
-	const SymbolType Epsilon = "#";
+	const char EpsilonCharacter = '#';
+	const SymbolType Epsilon(1, EpsilonCharacter);
+	const SymbolIdType EpsilonId = static_cast<unsigned char>(EpsilonCharacter);
 
 	template <class T>
 	std::ostream& operator<<(std::ostream& os, const std::set<T>& s)
@@ -0,0 +1,47 @@
+#ifndef CONCURRENTSUBSETTABLE_H_
+#define CONCURRENTSUBSETTABLE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Common.h"
+#include "StateBitSet.h"
+#include "SubsetTable.h"
+
+namespace Automata {
+
+// SubsetTable that many threads can intern into at once. Subsets are spread over shards
+// by hash, each shard is a SubsetTable behind its own mutex, and ids come from one shared
+// counter. Ids are dense but their order depends on thread timing.
+class ConcurrentSubsetTable
+{
+public:
+	using IdType = SubsetTable::IdType;
+	static constexpr size_t DefaultNumberOfShards = 64;
+
+private:
+	struct Shard
+	{
+		std::mutex mutex;
+		SubsetTable table;
+		std::vector<IdType> ids;
+		Shard(size_t numberOfStates):mutex(), table(numberOfStates), ids() {}
+	};
+
+	std::vector<std::unique_ptr<Shard>> _shards;
+	std::atomic<IdType> _size;
+
+public:
+	ConcurrentSubsetTable(size_t, size_t = DefaultNumberOfShards);
+	ConcurrentSubsetTable(const ConcurrentSubsetTable&) = delete;
+	ConcurrentSubsetTable& operator=(const ConcurrentSubsetTable&) = delete;
+	std::pair<IdType, bool> intern(const StateBitSet&);
+	size_t size() const { return _size; }
+};
+
+} /* namespace Automata */
+
+#endif /* CONCURRENTSUBSETTABLE_H_ */
@@ -3,10 +3,15 @@
 
 #include <algorithm>
 #include <iostream>
+#include <vector>
+#include <array>
+#include <map>
+#include <cstdint>
 
 #include "Common.h"
 #include "TransitionTable.h"
 #include "NFA.h"
+#include "Prefilter.h"
 
 namespace Automata {
 
@@ -22,7 +27,12 @@ public:
 	DFA(const NFA&);
 	StateType getInitialState() const;
 	StateSetType getFinalStates() const;
+	size_t getNumberOfStates() const;
 	StateType move(const StateType&, const SymbolType&) const;
+	StateType move(const StateType&, const SymbolIdType&) const;
+	// Empty when the state has no transition with the symbol
+	const StateSetType& getTargets(const StateType&, const SymbolIdType&) const;
+	const std::vector<SymbolIdType>& getSymbolIds() const;
 	TransitionTable::TransitionIteratorTag getTransitions(const StateType& state) const;
 	// Friend classes
 	friend class DFARunner;
@@ -38,9 +48,10 @@ template <class LabelType>
 class DFABuilder
 {
 protected:
-	using TransitionType = std::tuple<LabelType, SymbolType, LabelType>;
+	using TransitionType = std::tuple<LabelType, SymbolIdType, LabelType>;
 
 	std::vector<TransitionType> _transitions;
+	std::map<std::pair<LabelType, SymbolIdType>, LabelType> _targets;
 	NFABuilder<LabelType> _nfaBuilder;
 
 public:
@@ -51,15 +62,23 @@ public:
 	void addFinalStateLabel(const LabelType& finalStateLabel){ _nfaBuilder.addFinalStateLabel(finalStateLabel); }
 	void addTransition(const LabelType& startLabel, const SymbolType& symbol, const LabelType& finalLabel)
 	{
-		if(symbol == Epsilon)
+		addTransition(startLabel, SymbolTable::intern(symbol), finalLabel);
+	}
+	void addTransition(const LabelType& startLabel, const SymbolIdType& symbol, const LabelType& finalLabel)
+	{
+		if(symbol == EpsilonId)
 			throw std::invalid_argument("Epsilon can not be used as a transition symbol.");
-		for(const auto& t: _transitions)
-			if(std::get<0>(t) == startLabel && std::get<1>(t) == symbol && std::get<2>(t) != finalLabel)
+		const auto key = std::make_pair(startLabel, symbol);
+		const auto iter = _targets.find(key);
+		if(iter != std::end(_targets))
+		{
+			if(iter->second != finalLabel)
 				throw std::invalid_argument("Same source and same symbol can not go to different targets.");
+			return;
+		}
 
-		const auto transition = std::make_tuple(startLabel, symbol, finalLabel);
-		if(std::find(std::begin(_transitions), std::end(_transitions), transition) == std::end(_transitions))
-			_transitions.push_back(transition);
+		_targets.emplace(key, finalLabel);
+		_transitions.push_back(std::make_tuple(startLabel, symbol, finalLabel));
 	}
 	DFA build()
 	{
@@ -69,16 +88,60 @@ public:
 	}
 };
 
+// Flat jump table over byte classes: bytes with identical columns share a class and
+// row state * numberOfClasses + class holds the next state. Missing transitions go to an
+// extra, non accepting, dead state. An unanchored DenseDFA, built from
+// Powerset::applyUnanchored, sends them back to the initial state instead.
+class DenseDFA
+{
+public:
+	using IndexType = std::uint32_t;
+	using ClassType = std::uint8_t;
+	static constexpr size_t AlphabetSize = 256;
+
+protected:
+	std::array<ClassType, AlphabetSize> _byteClasses;
+	size_t _numberOfClasses;
+	std::vector<IndexType> _table;
+	std::vector<std::uint64_t> _accepting;
+	IndexType _initialState;
+	IndexType _deadState;
+
+public:
+	DenseDFA(const DFA&, const bool& unanchored = false);
+	IndexType getInitialState() const { return _initialState; }
+	IndexType getDeadState() const { return _deadState; }
+	size_t getNumberOfStates() const { return _table.size() / _numberOfClasses; }
+	size_t getNumberOfClasses() const { return _numberOfClasses; }
+	const std::array<ClassType, AlphabetSize>& getByteClasses() const { return _byteClasses; }
+	const std::vector<IndexType>& getTable() const { return _table; }
+	IndexType next(const IndexType& state, const unsigned char& byte) const
+	{
+		return _table[static_cast<size_t>(state) * _numberOfClasses + _byteClasses[byte]];
+	}
+	bool isAccepting(const IndexType& state) const
+	{
+		return (_accepting[state >> 6] >> (state & 63)) & 1;
+	}
+	IndexType run(const char*, size_t, IndexType) const;
+	bool matches(const char*, size_t) const;
+};
+
 class DFARunner
 {
 protected:
-	NFARunner _runner;
+	const DenseDFA _dense;
+	const Prefilter _prefilter;
+	// Set once so runs without literals skip the prefilter entirely
+	const bool _filtered;
 
 public:
-	DFARunner(const DFA&);
+	DFARunner(const DFA&, const Prefilter& = Prefilter());
 	DFARunner(const DFARunner&) = delete;
 	DFARunner& operator=(const DFARunner&) = delete;
-	bool run(const std::string&);
+	bool run(const std::string&) const;
+	const DenseDFA& getDenseDFA() const { return _dense; }
+	const Prefilter& getPrefilter() const { return _prefilter; }
 };
 
 } /* namespace Automata */
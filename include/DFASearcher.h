@@ -0,0 +1,85 @@
+#ifndef DFASEARCHER_H_
+#define DFASEARCHER_H_
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+#include "Common.h"
+#include "NFA.h"
+#include "DFA.h"
+#include "Prefilter.h"
+
+namespace Automata {
+
+// Half open range [begin, end) of the input
+struct Match
+{
+	size_t begin;
+	size_t end;
+};
+
+// Leftmost longest substring search. The DFA of .*R runs forward to the earliest end of any
+// match, then the DFA of R^r runs back from it and finds the leftmost match ending there.
+// Matches starting further left have to reach past that end, so only the starts before it
+// are tried, each by running the DFA of R forward until it dies. Those forward scans remember
+// the positions and states from which nothing accepts any more, and stop when they reach
+// one again. Each pair is scanned once, so a search is linear in the input for a given DFA,
+// also when matches such as a|a.a*.c keep the DFA alive far past their ends.
+class DFASearcher
+{
+private:
+	static constexpr size_t Unknown = static_cast<size_t>(-1);
+
+	// Pairs of position and state of _forward found to accept nothing more
+	struct Doomed
+	{
+		std::unordered_set<std::uint64_t> pairs;
+		size_t reached = 0;
+		std::vector<std::uint64_t> path;
+	};
+
+protected:
+	const DenseDFA _forward;
+	const DenseDFA _unanchored;
+	const DenseDFA _reverse;
+	const Prefilter _prefilter;
+
+public:
+	DFASearcher(const NFA&, const Prefilter& = Prefilter());
+	// The minimal DFAs of R, of .*R and of R^r
+	DFASearcher(const DFA& anchored, const DFA& unanchored, const DFA& reverse, const Prefilter& = Prefilter());
+	DFASearcher(const DFASearcher&) = delete;
+	DFASearcher& operator=(const DFASearcher&) = delete;
+	bool findFirst(const std::string&, Match&, const size_t& from = 0) const;
+	std::vector<Match> findAll(const std::string&) const;
+	size_t count(const std::string&) const;
+
+private:
+	bool mayMatch(const std::string&, const size_t&) const;
+	bool find(const std::string&, const size_t&, Match&, Doomed&) const;
+	size_t earliestEnd(const std::string&, const size_t&) const;
+	size_t leftmostStart(const std::string&, const size_t&, const size_t&) const;
+	size_t nextCandidate(const std::string&, const size_t&, const size_t&) const;
+	size_t longestEnd(const std::string&, const size_t&, Doomed&) const;
+	template <class Function>
+	void forEach(const std::string& input, Function function) const
+	{
+		if(!mayMatch(input, 0))
+			return;
+		// Non overlapping, an empty match moves the search one byte forward
+		Doomed doomed;
+		Match match;
+		size_t from = 0;
+		while(find(input, from, match, doomed))
+		{
+			function(match);
+			from = match.end > match.begin ? match.end : match.end + 1;
+		}
+	}
+};
+
+} /* namespace Automata */
+
+#endif /* DFASEARCHER_H_ */
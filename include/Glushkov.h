@@ -0,0 +1,42 @@
+#ifndef GLUSHKOV_H_
+#define GLUSHKOV_H_
+
+#include <string>
+#include <vector>
+
+#include <Common.h>
+#include <NFA.h>
+#include <RegexParser.h>
+
+namespace Automata {
+
+// Position automaton: one state per symbol occurrence plus the initial state,
+// and no epsilon transitions at all.
+class Glushkov
+{
+private:
+	using PositionsType = std::vector<StateType>;
+	struct Fragment
+	{
+		bool nullable;
+		PositionsType first;
+		PositionsType last;
+	};
+
+public:
+	Glushkov() = delete;
+	static Automata::NFA apply(const std::string&);
+	static Automata::NFA apply(const RegexAST&);
+
+private:
+	static Automata::NFA build(const Fragment&, const std::vector<SymbolIdType>&, std::vector<PositionsType>&);
+	static Fragment concatenation(const Fragment&, const Fragment&, std::vector<PositionsType>&);
+	static Fragment alternative(const Fragment&, const Fragment&);
+	static Fragment kleene(const Fragment&, std::vector<PositionsType>&);
+	static PositionsType merge(const PositionsType&, const PositionsType&);
+	static void addFollow(std::vector<PositionsType>&, const PositionsType&, const PositionsType&);
+};
+
+} /* namespace Automata */
+
+#endif /* GLUSHKOV_H_ */
@@ -1,36 +1,70 @@
 #ifndef HOPCROFT_HOPCROFT_H_
 #define HOPCROFT_HOPCROFT_H_
 
+#include <vector>
+#include <utility>
+
 #include <Common.h>
 #include <DFA.h>
+#include <SymbolClasses.h>
+#include <ThreadPool.h>
 
 namespace Automata {
 
 class Hopcroft {
 private:
-	using IdType = int;
-	struct Group
+	using IdType = StateType;
+	// Flat transition function over symbol classes, row state * numberOfClasses. Missing
+	// transitions go to an extra sink state so the function is total. States start out
+	// grouped by the patterns they accept, group 0 accepts none.
+	struct TotalDFA
 	{
-		StateSetType states;
-		IdType id;
-		bool operator<(const Group& rhs) const { return id < rhs.id; }
-		bool operator==(const Group& rhs) const { return states == rhs.states; }
-		bool operator!=(const Group& rhs) const { return !operator==(rhs); }
+		std::vector<std::vector<SymbolIdType>> classes;
+		std::vector<StateType> transitions;
+		std::vector<IdType> group;
+		std::vector<PatternSetType> groupPatterns;
+		std::vector<bool> reachable;
+		StateType initialState;
+		StateType sinkState;
+		size_t numberOfStates() const { return group.size(); }
+		bool isAccepting(const StateType& state) const { return group[state] != 0; }
+		StateType move(const StateType& state, const size_t& symbolClass) const { return transitions[state * classes.size() + symbolClass]; }
+	};
+	// Blocks are contiguous ranges of elements; marked states sit at the front of their block
+	class Partition
+	{
+	public:
+		std::vector<StateType> elements;
+		std::vector<size_t> location;
+		std::vector<IdType> blockOf;
+		std::vector<size_t> blockStart;
+		std::vector<size_t> blockEnd;
+		std::vector<size_t> marked;
+
+		Partition(const std::vector<StateType>&, const std::vector<IdType>&, const size_t&);
+		size_t numberOfBlocks() const { return blockStart.size(); }
+		size_t blockSize(const IdType& block) const { return blockEnd[block] - blockStart[block]; }
+		bool mark(const StateType&);
+		IdType split(const IdType&);
 	};
-	using PartitionType = std::set<Group>;
 
 public:
 	Hopcroft() = delete;
 	static DFA apply(const DFA&);
+	// States accepting different pattern sets are never merged. patterns has one entry per
+	// state of the input, minimalPatterns gets one per state of the result.
+	static DFA apply(const DFA&, const std::vector<PatternSetType>& patterns, std::vector<PatternSetType>& minimalPatterns);
+	// Same DFA as apply, refined Moore style: every round splits all blocks at once by
+	// successor blocks, with the blocks shared out over the pool. Rounds are bounded by the
+	// DFA depth rather than log n, the price for the rounds being parallel.
+	static DFA applyParallel(const DFA&, ThreadPool&);
 
 private:
-	static PartitionType initialPartition(const DFA&);
-	static PartitionType improvePartition(const DFA&, const PartitionType&, const AlphabetType&);
-	static AlphabetType getAlphabet(const DFA&);
-	static IdType findGroupId(const PartitionType&, const StateType&);
-	static void printPartition(const PartitionType&);
-	static void printGroup(const Group&);
-
+	static std::vector<PatternSetType> finalStatePatterns(const DFA&);
+	static TotalDFA makeTotal(const DFA&, const std::vector<PatternSetType>&);
+	static std::vector<IdType> refine(const TotalDFA&);
+	static std::vector<IdType> refineParallel(const TotalDFA&, ThreadPool&);
+	static DFA buildMinimal(const TotalDFA&, const std::vector<IdType>&, std::vector<PatternSetType>&);
 };
 
 } /* namespace Automata */
@@ -0,0 +1,50 @@
+#ifndef JITMATCHER_H_
+#define JITMATCHER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "DFA.h"
+
+namespace Automata {
+
+// Compiles a DenseDFA to native code on x86-64 Linux. Every live state becomes a block that
+// checks for the end of input, loads the next byte and dispatches on it: a chain of compares
+// over byte ranges when the state has few distinct ranges, or a jump through the byte class
+// map and a per state table otherwise. The dead state is an early return. Elsewhere, or if
+// no executable memory can be mapped, matching falls back to walking the DenseDFA table.
+class JITMatcher
+{
+public:
+	// States with more non default byte ranges than this use a jump table
+	static constexpr size_t MaxCompareRanges = 6;
+
+private:
+	using Function = int (*)(const unsigned char*, const unsigned char*);
+
+	const DenseDFA& _dfa;
+	void* _code;
+	size_t _codeSize;
+	Function _function;
+
+public:
+	JITMatcher(const DenseDFA&);
+	// Only a reference to the DFA is kept, so it can not be a temporary
+	JITMatcher(DenseDFA&&) = delete;
+	JITMatcher(const JITMatcher&) = delete;
+	JITMatcher& operator=(const JITMatcher&) = delete;
+	~JITMatcher();
+	bool matches(const char*, size_t) const;
+	bool matches(const std::string& input) const { return matches(input.data(), input.size()); }
+	bool isCompiled() const { return _function != nullptr; }
+	size_t getCodeSize() const { return _codeSize; }
+
+private:
+	static std::vector<std::uint8_t> assemble(const DenseDFA&);
+};
+
+} /* namespace Automata */
+
+#endif /* JITMATCHER_H_ */
@@ -0,0 +1,66 @@
+#ifndef LAZYDFA_H_
+#define LAZYDFA_H_
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "Common.h"
+#include "NFA.h"
+#include "StateBitSet.h"
+#include "SubsetTable.h"
+
+namespace Automata {
+
+// Determinizes an NFA on the fly: only the subsets the input reaches become DFA states.
+// States and transitions are cached until they exceed the memory budget, then the whole
+// cache is flushed and rebuilt from the current subset.
+class LazyDFARunner
+{
+public:
+	using ClassType = std::uint8_t;
+	static constexpr size_t AlphabetSize = 256;
+	static constexpr size_t DefaultMemoryBudget = 1 << 20;
+
+private:
+	static constexpr StateType Unknown = static_cast<StateType>(-1);
+
+	const size_t _numberOfStates;
+	const size_t _memoryBudget;
+	std::array<ClassType, AlphabetSize> _byteClasses;
+	size_t _numberOfClasses;
+	std::vector<StateBitSet> _closures;
+	std::vector<size_t> _edgeOffsets;
+	std::vector<ClassType> _edgeClasses;
+	std::vector<StateType> _edgeTargets;
+	StateBitSet _finalStates;
+	StateBitSet _startSubset;
+
+	SubsetTable _cache;
+	std::vector<StateType> _transitions;
+	std::vector<bool> _accepting;
+	StateType _startState;
+	StateType _deadState;
+	size_t _numberOfFlushes;
+
+	StateBitSet _current;
+	StateBitSet _next;
+
+public:
+	LazyDFARunner(const NFA&, size_t = DefaultMemoryBudget);
+	LazyDFARunner(const LazyDFARunner&) = delete;
+	LazyDFARunner& operator=(const LazyDFARunner&) = delete;
+	bool run(const std::string&);
+	size_t getNumberOfCachedStates() const { return _cache.size(); }
+	size_t getNumberOfFlushes() const { return _numberOfFlushes; }
+	size_t getMemoryUsage() const;
+
+private:
+	StateType computeTransition(const StateType&, const ClassType&);
+	StateType addState(const StateBitSet&);
+	void flush();
+};
+
+} /* namespace Automata */
+
+#endif /* LAZYDFA_H_ */
@@ -0,0 +1,87 @@
+#ifndef MAPPEDDFA_H_
+#define MAPPEDDFA_H_
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "Common.h"
+#include "DFA.h"
+#include "MappedFile.h"
+
+namespace Automata {
+
+// Binary image of a DenseDFA that is used in place, straight from an mmap'd file or any
+// 8 byte aligned buffer. Offsets are relative to the image start, so it can live at any
+// address. Layout, version 1, in host byte order:
+//   Header, the byte class of each of the 256 bytes, padding to 8 bytes,
+//   table of numberOfStates * numberOfClasses uint32 targets, padding to 8 bytes,
+//   accepting bitmap of (numberOfStates + 63) / 64 uint64 words.
+// Loading only validates the header and that every target is a valid state.
+class MappedDFA
+{
+public:
+	using IndexType = DenseDFA::IndexType;
+	using ClassType = DenseDFA::ClassType;
+	static constexpr std::uint32_t Version = 1;
+
+private:
+	struct Header
+	{
+		char magic[8];
+		std::uint32_t byteOrder;
+		std::uint32_t version;
+		std::uint32_t numberOfStates;
+		std::uint32_t numberOfClasses;
+		std::uint32_t initialState;
+		std::uint32_t deadState;
+		std::uint64_t classesOffset;
+		std::uint64_t tableOffset;
+		std::uint64_t acceptingOffset;
+		std::uint64_t size;
+	};
+	static constexpr char Magic[8] = {'A', 'U', 'T', 'O', 'D', 'F', 'A', '\0'};
+	static constexpr std::uint32_t ByteOrder = 0x01020304;
+
+	std::unique_ptr<MappedFile> _file;
+	const ClassType* _byteClasses;
+	const IndexType* _table;
+	const std::uint64_t* _accepting;
+	size_t _numberOfStates;
+	size_t _numberOfClasses;
+	IndexType _initialState;
+	IndexType _deadState;
+
+public:
+	MappedDFA(const std::string&);
+	MappedDFA(const char*, size_t);
+	MappedDFA(const MappedDFA&) = delete;
+	MappedDFA& operator=(const MappedDFA&) = delete;
+	IndexType getInitialState() const { return _initialState; }
+	IndexType getDeadState() const { return _deadState; }
+	size_t getNumberOfStates() const { return _numberOfStates; }
+	size_t getNumberOfClasses() const { return _numberOfClasses; }
+	IndexType next(const IndexType& state, const unsigned char& byte) const
+	{
+		return _table[static_cast<size_t>(state) * _numberOfClasses + _byteClasses[byte]];
+	}
+	bool isAccepting(const IndexType& state) const
+	{
+		return (_accepting[state >> 6] >> (state & 63)) & 1;
+	}
+	IndexType run(const char*, size_t, IndexType) const;
+	bool matches(const char*, size_t) const;
+	bool matches(const std::string& input) const { return matches(input.data(), input.size()); }
+
+	static void write(const DenseDFA&, std::ostream&);
+	static void save(const DenseDFA&, const std::string&);
+
+private:
+	void load(const char*, size_t);
+	static std::uint64_t align(const std::uint64_t& offset) { return (offset + 7) & ~std::uint64_t(7); }
+};
+
+} /* namespace Automata */
+
+#endif /* MAPPEDDFA_H_ */
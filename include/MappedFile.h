@@ -0,0 +1,27 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <string>
+
+namespace Automata {
+
+// Read only view of a whole file through mmap, so large inputs are scanned straight
+// from the page cache without being copied. Empty files map to an empty range.
+class MappedFile
+{
+private:
+	const char* _data;
+	size_t _size;
+
+public:
+	MappedFile(const std::string&);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+	const char* data() const { return _data; }
+	size_t size() const { return _size; }
+};
+
+} /* namespace Automata */
+
+#endif /* MAPPEDFILE_H_ */
@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "TransitionTable.h"
+#include "StateBitSet.h"
 #include "Common.h"
 
 namespace Automata {
@@ -25,8 +26,11 @@ public:
 	StateType getInitialState() const;
 	const StateSetType& getFinalStates() const;
 	StateSetType getFinalStates();
+	size_t getNumberOfStates() const;
 	const StateSetType& move(const StateType&, const SymbolType&) const;
 	StateSetType move(const StateType&, const SymbolType&);
+	const StateSetType& move(const StateType&, const SymbolIdType&) const;
+	const std::vector<SymbolIdType>& getSymbolIds() const;
 	TransitionTable::TransitionIteratorTag getTransitions(const StateType&) const;
 	~NFA() = default;
 	// Friend classes
@@ -44,7 +48,7 @@ template <class LabelType>
 class NFABuilder
 {
 protected:
-	using TransitionType = std::tuple<LabelType, SymbolType, LabelType>;
+	using TransitionType = std::tuple<LabelType, SymbolIdType, LabelType>;
 
 	std::vector<TransitionType> _transitions;
 	LabelType _initialStateLabel;
@@ -66,6 +70,10 @@ public:
 		_finalStatesLabels.insert(finalStateLabel);
 	}
 	void addTransition(const LabelType& startLabel, const SymbolType& symbol, const LabelType& endLabel)
+	{
+		addTransition(startLabel, SymbolTable::intern(symbol), endLabel);
+	}
+	void addTransition(const LabelType& startLabel, const SymbolIdType& symbol, const LabelType& endLabel)
 	{
 		_transitions.push_back(std::make_tuple(startLabel, symbol, endLabel));
 	}
@@ -108,13 +116,13 @@ public:
 	~NFABuilder() = default;
 
 protected:
-	AlphabetType buildAlphabet() const
+	std::set<SymbolIdType> buildAlphabet() const
 	{
-		AlphabetType alphabet;
+		std::set<SymbolIdType> alphabet;
 		for(const auto& t: _transitions)
 		{
-			const SymbolType symbol = std::get<1>(t);
-			if(symbol != Epsilon)
+			const SymbolIdType symbol = std::get<1>(t);
+			if(symbol != EpsilonId)
 				alphabet.insert(symbol);
 		}
 		return alphabet;
@@ -142,23 +150,67 @@ protected:
 class EpsilonClosure
 {
 private:
-	using MappingType = std::map<StateType, StateSetType>;
+	using MappingType = std::vector<StateBitSet>;
 
 	MappingType _mapping;
+	size_t _numberOfStates;
 
 public:
 	EpsilonClosure(const NFA&);
-	const StateSetType& getClosure(const StateType&) const;
-	StateSetType getClosure(const StateType&);
+	StateSetType getClosure(const StateType&) const;
 	StateSetType getClosure(const StateSetType&) const;
+	const StateBitSet& getClosureBits(const StateType&) const;
+	StateBitSet getClosure(const StateBitSet&) const;
+	void getClosure(const StateBitSet&, StateBitSet&) const;
+	size_t getNumberOfStates() const { return _numberOfStates; }
 
 	static StateSetType calculateClosure(const NFA&, const StateType&);
 };
 
+// Sparse set over [0, capacity): O(1) insert, lookup and clear, iteration in insertion order
+class SparseStateSet
+{
+private:
+	std::vector<StateType> _dense;
+	std::vector<StateType> _sparse;
+	size_t _size;
+
+public:
+	SparseStateSet(size_t capacity):_dense(capacity), _sparse(capacity), _size(0) {}
+	bool contains(const StateType& state) const
+	{
+		const StateType index = _sparse[state];
+		return index < _size && _dense[index] == state;
+	}
+	bool insert(const StateType& state)
+	{
+		if(contains(state))
+			return false;
+		_sparse[state] = static_cast<StateType>(_size);
+		_dense[_size++] = state;
+		return true;
+	}
+	void clear() { _size = 0; }
+	bool empty() const { return _size == 0; }
+	size_t size() const { return _size; }
+	const StateType* begin() const { return _dense.data(); }
+	const StateType* end() const { return _dense.data() + _size; }
+};
+
+// Pike VM style simulation. Closures and byte transitions are flattened once at construction
+// and every run steps between two preallocated sparse sets.
 class NFARunner
 {
 private:
 	const NFA _nfa;
+	std::vector<size_t> _closureOffsets;
+	std::vector<StateType> _closureStates;
+	std::vector<size_t> _edgeOffsets;
+	std::vector<unsigned char> _edgeBytes;
+	std::vector<StateType> _edgeTargets;
+	std::vector<bool> _accepting;
+	SparseStateSet _currentStates;
+	SparseStateSet _nextStates;
 
 public:
 	NFARunner(const NFA&);
@@ -167,7 +219,8 @@ public:
 	bool run(const std::string&);
 
 private:
-	bool finalStateReached(const StateSetType&, const StateSetType&) const;
+	void addClosure(SparseStateSet&, const StateType&) const;
+	bool finalStateReached(const SparseStateSet&) const;
 };
 
 } /* namespace Automata */
@@ -0,0 +1,47 @@
+#ifndef PARALLELMATCHER_H_
+#define PARALLELMATCHER_H_
+
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "DFA.h"
+#include "ThreadPool.h"
+
+namespace Automata {
+
+// Matches one large input on several cores. The input is cut into chunks; the first one
+// runs from the initial state and every other chunk is run from all DFA states at once,
+// giving a map from the state it is entered in to the state it is left in. Composing
+// the maps in order yields the final state. Paths that reach the same state merge and
+// are followed once, but some DFAs never merge them, a counter modulo n keeps n paths, so
+// the enumeration costs up to states times chunk size. A chunk still following more than
+// MaxPaths paths after a block gives up and is run sequentially once its entry state is known.
+// Concurrent run calls on one matcher are serialized by the run mutex of its pool.
+class ParallelMatcher
+{
+public:
+	using IndexType = DenseDFA::IndexType;
+	static constexpr size_t MinimumChunkSize = 1 << 16;
+	static constexpr size_t MaxPaths = 16;
+
+protected:
+	const DenseDFA& _dfa;
+	mutable ThreadPool _pool;
+
+public:
+	ParallelMatcher(const DenseDFA&, const size_t& numberOfThreads = ThreadPool::defaultNumberOfThreads());
+	// Only a reference to the DFA is kept, so it can not be a temporary
+	ParallelMatcher(DenseDFA&&, const size_t& = 0) = delete;
+	ParallelMatcher(const ParallelMatcher&) = delete;
+	ParallelMatcher& operator=(const ParallelMatcher&) = delete;
+	IndexType run(const char*, size_t, IndexType) const;
+	bool matches(const char*, size_t) const;
+	bool matches(const std::string& input) const { return matches(input.data(), input.size()); }
+	// Empty when more than MaxPaths paths survive a block
+	std::vector<IndexType> mapChunk(const char*, size_t) const;
+};
+
+} /* namespace Automata */
+
+#endif /* PARALLELMATCHER_H_ */
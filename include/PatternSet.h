@@ -0,0 +1,39 @@
+#ifndef PATTERNSET_H_
+#define PATTERNSET_H_
+
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "NFA.h"
+#include "DFA.h"
+
+namespace Automata {
+
+// Compiles many regexes into a single minimal DFA whose accepting states carry the ids of
+// the patterns they accept for, so one pass over an input reports every pattern that
+// matches it. Pattern ids are positions in the list given to the constructor.
+class PatternSet
+{
+protected:
+	const size_t _numberOfPatterns;
+	std::vector<PatternSetType> _patterns;
+	const DenseDFA _dense;
+
+public:
+	PatternSet(const std::vector<std::string>&);
+	PatternSet(const PatternSet&) = delete;
+	PatternSet& operator=(const PatternSet&) = delete;
+	size_t size() const { return _numberOfPatterns; }
+	const DenseDFA& getDenseDFA() const { return _dense; }
+	const PatternSetType& getPatterns(const DenseDFA::IndexType& state) const { return _patterns[state]; }
+	const PatternSetType& match(const std::string&) const;
+
+private:
+	static NFA unite(const std::vector<NFA>&, std::vector<PatternSetType>&);
+	static DFA compile(const std::vector<std::string>&, std::vector<PatternSetType>&);
+};
+
+} /* namespace Automata */
+
+#endif /* PATTERNSET_H_ */
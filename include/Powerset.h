@@ -2,9 +2,12 @@
 #define POWERSET_H_
 
 #include <map>
-#include <queue>
+#include <vector>
 #include <NFA.h>
 #include <DFA.h>
+#include <SubsetTable.h>
+#include <SymbolClasses.h>
+#include <ThreadPool.h>
 
 namespace Automata {
 
@@ -13,11 +16,23 @@ class Powerset
 public:
 	Powerset() = delete;
 	static DFA apply(const NFA&);
+	// DFA for .*R, every subset also holds the initial closure so a match may start anywhere.
+	// Bytes outside the NFA alphabet restart it, see DenseDFA's unanchored mode.
+	static DFA applyUnanchored(const NFA&);
+	// patterns has one entry per NFA state, each DFA state gets the union over its subset
+	static DFA apply(const NFA&, const std::vector<PatternSetType>& patterns, std::vector<PatternSetType>& dfaPatterns);
+	// Same DFA as apply, with subsets expanded by all threads of the pool. Workers keep new
+	// subsets in their own deque, idle workers steal, and subsets are interned concurrently.
+	static DFA applyParallel(const NFA&, ThreadPool&);
 private:
-	static StateSetType moveOverSet(const NFA&, const StateSetType&, const SymbolType&);
-	static AlphabetType getAlphabet(const NFA&);
-	static StateSetType multipleMove(const NFA&, const StateSetType&, const SymbolType&);
-	static bool containsAFinalState(const StateSetType&, const StateSetType&);
+	static DFA build(const NFA&, const bool&, const std::vector<PatternSetType>&, std::vector<PatternSetType>&);
+	static std::vector<std::vector<SymbolIdType>> getClassSymbols(const NFA&);
+	static DFA makeDFA(const std::vector<std::vector<SymbolIdType>>&, const std::vector<SubsetTable::IdType>&,
+			const std::vector<PatternSetType>&);
+	static std::vector<PatternSetType> finalStatePatterns(const NFA&);
+	static StateSetType moveOverSet(const NFA&, const StateSetType&, const SymbolIdType&);
+	static void multipleMove(const NFA&, const StateBitSet&, const SymbolIdType&, StateBitSet&);
+	static void mergePatterns(const StateBitSet&, const std::vector<PatternSetType>&, PatternSetType&);
 };
 
 } /* namespace Automata */
@@ -0,0 +1,52 @@
+#ifndef PREFILTER_H_
+#define PREFILTER_H_
+
+#include <string>
+
+#include "Common.h"
+#include "RegexParser.h"
+
+namespace Automata {
+
+// Literals every word of a regex must contain: a prefix, a suffix and the longest inner factor.
+// (a|b)*.a.b.b has no prefix, and abb as both suffix and factor. Inputs missing any of
+// them are rejected with memchr/memcmp before an automaton touches a single byte.
+class Prefilter
+{
+private:
+	struct Literals
+	{
+		bool exact;
+		std::string prefix;
+		std::string suffix;
+		std::string factor;
+	};
+
+	std::string _prefix;
+	std::string _suffix;
+	std::string _factor;
+	// False when the factor is empty or is the prefix or suffix, which are checked anyway
+	bool _searchFactor = false;
+
+public:
+	Prefilter() = default;
+	Prefilter(const RegexAST&);
+	Prefilter(const std::string& prefix, const std::string& suffix, const std::string& factor);
+	const std::string& getPrefix() const { return _prefix; }
+	const std::string& getSuffix() const { return _suffix; }
+	const std::string& getFactor() const { return _factor; }
+	bool empty() const { return _prefix.empty() && _suffix.empty() && _factor.empty(); }
+	bool mayMatch(const char*, size_t) const;
+	const char* findFactor(const char*, const char*) const;
+	static const char* find(const char*, const char*, const std::string&);
+
+private:
+	static Literals symbol(const SymbolIdType&);
+	static Literals concatenation(const Literals&, const Literals&);
+	static Literals alternative(const Literals&, const Literals&);
+	static const std::string& longest(const std::string&, const std::string&);
+};
+
+} /* namespace Automata */
+
+#endif /* PREFILTER_H_ */
@@ -0,0 +1,70 @@
+#ifndef REGEXCACHE_H_
+#define REGEXCACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Common.h"
+#include "DFA.h"
+#include "RegexParser.h"
+
+namespace Automata {
+
+// Thread safe cache of minimal DFAs keyed by the normalized regex, the postfix form of its
+// optimized AST, so a.b and ab share an entry. Least recently used entries are evicted
+// once the estimated memory of the cached DFAs exceeds the budget. DFAs are handed out as
+// shared immutable pointers and stay valid after eviction.
+class RegexCache
+{
+public:
+	using DFAPointer = std::shared_ptr<const DFA>;
+	static constexpr size_t DefaultMemoryBudget = 64 << 20;
+
+private:
+	struct Entry
+	{
+		std::string key;
+		DFAPointer dfa;
+		size_t memory;
+	};
+
+	const size_t _memoryBudget;
+	mutable std::mutex _mutex;
+	std::list<Entry> _entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+	size_t _memoryUsage;
+	size_t _hits;
+	size_t _misses;
+	size_t _evictions;
+
+public:
+	RegexCache(const size_t& memoryBudget = DefaultMemoryBudget);
+	RegexCache(const RegexCache&) = delete;
+	RegexCache& operator=(const RegexCache&) = delete;
+	DFAPointer get(const std::string&);
+	DFAPointer get(const RegexAST&);
+	DFAPointer find(const RegexAST&);
+	DFAPointer insert(const RegexAST&, const DFA&);
+	void clear();
+	size_t size() const;
+	size_t getMemoryUsage() const;
+	size_t getHits() const;
+	size_t getMisses() const;
+	size_t getEvictions() const;
+	static std::string normalize(const RegexAST&);
+	// Minimal DFA of the optimized regex, the pipeline every cached entry is built with
+	static DFA compile(const RegexAST&);
+	static size_t estimateMemory(const DFA&);
+
+private:
+	DFAPointer find(const std::string&);
+	DFAPointer insert(const std::string&, const DFAPointer&);
+	static DFA build(const RegexAST&);
+};
+
+} /* namespace Automata */
+
+#endif /* REGEXCACHE_H_ */
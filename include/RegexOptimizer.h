@@ -0,0 +1,53 @@
+#ifndef REGEXOPTIMIZER_H_
+#define REGEXOPTIMIZER_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include "RegexParser.h"
+
+namespace Automata {
+
+// Rewrites a RegexAST into an equivalent, usually smaller one:
+// - identical subtrees are hash-consed into a single node,
+// - duplicate alternatives are removed,
+// - common prefixes and suffixes are factored out of alternatives, a.b|a.c is a.(b|c),
+// - nested stars collapse, (x*)* is x*, and # is dropped from concatenations.
+class RegexOptimizer
+{
+private:
+	using NodeIdType = RegexAST::NodeIdType;
+	using SequenceType = std::vector<NodeIdType>;
+	struct NodeHash
+	{
+		size_t operator()(const RegexAST::Node&) const;
+	};
+	struct NodeEqual
+	{
+		bool operator()(const RegexAST::Node&, const RegexAST::Node&) const;
+	};
+
+	const RegexAST& _input;
+	RegexAST _output;
+	std::unordered_map<RegexAST::Node, NodeIdType, NodeHash, NodeEqual> _nodes;
+
+public:
+	static RegexAST apply(const RegexAST&);
+
+private:
+	RegexOptimizer(const RegexAST& input):_input(input), _output(), _nodes() {}
+	NodeIdType optimize(const NodeIdType&);
+	NodeIdType optimizeConcatenation(const NodeIdType&);
+	NodeIdType optimizeAlternative(const NodeIdType&);
+	NodeIdType optimizeKleene(const NodeIdType&);
+	NodeIdType factor(const std::vector<NodeIdType>&, const size_t&);
+	NodeIdType makeSequence(const SequenceType&, const size_t&, const size_t&, const size_t&);
+	NodeIdType makeAlternatives(const std::vector<NodeIdType>&, const size_t&);
+	NodeIdType makeEpsilon(const size_t&);
+	NodeIdType intern(const RegexAST::Node&);
+	SequenceType getSequence(const NodeIdType&) const;
+};
+
+} /* namespace Automata */
+
+#endif /* REGEXOPTIMIZER_H_ */
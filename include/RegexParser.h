@@ -0,0 +1,134 @@
+#ifndef REGEXPARSER_H_
+#define REGEXPARSER_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+
+#include "Common.h"
+
+namespace Automata {
+
+// Regular expression tree stored in a single arena. Children always come before their
+// parent, so walking the nodes in order visits every subexpression bottom up. Subtrees may
+// be shared by several parents (see RegexOptimizer).
+class RegexAST
+{
+public:
+	using NodeIdType = unsigned int;
+	enum class Kind { Symbol, Epsilon, Concatenation, Alternative, Kleene };
+	struct Node
+	{
+		Kind kind;
+		SymbolIdType symbol;
+		NodeIdType left;
+		NodeIdType right;
+		size_t position;
+	};
+	static constexpr NodeIdType NoNode = static_cast<NodeIdType>(-1);
+
+private:
+	std::vector<Node> _nodes;
+	NodeIdType _root;
+
+public:
+	RegexAST():_nodes(), _root(NoNode) {}
+	NodeIdType addSymbol(const SymbolIdType&, const size_t&);
+	NodeIdType addEpsilon(const size_t&);
+	NodeIdType addConcatenation(const NodeIdType&, const NodeIdType&, const size_t&);
+	NodeIdType addAlternative(const NodeIdType&, const NodeIdType&, const size_t&);
+	NodeIdType addKleene(const NodeIdType&, const size_t&);
+	void setRoot(const NodeIdType& root) { _root = root; }
+	NodeIdType getRoot() const { return _root; }
+	const Node& getNode(const NodeIdType& id) const { return _nodes[id]; }
+	size_t size() const { return _nodes.size(); }
+	std::vector<Node>::const_iterator begin() const { return _nodes.begin(); }
+	std::vector<Node>::const_iterator end() const { return _nodes.end(); }
+	// Evaluates the expression bottom up from the root. A subtree shared by several parents is
+	// evaluated once per parent, function gets the node and its children results (or nullptr).
+	template <class ResultType, class Function>
+	ResultType evaluate(Function function) const
+	{
+		std::vector<ResultType> results;
+		std::vector<std::pair<NodeIdType, bool>> pending({{_root, false}});
+		while(!pending.empty())
+		{
+			const NodeIdType id = pending.back().first;
+			const bool childrenDone = pending.back().second;
+			pending.pop_back();
+			const Node& node = _nodes[id];
+
+			if(!childrenDone && node.left != NoNode)
+			{
+				pending.emplace_back(id, true);
+				if(node.right != NoNode)
+					pending.emplace_back(node.right, false);
+				pending.emplace_back(node.left, false);
+				continue;
+			}
+
+			if(node.right != NoNode)
+			{
+				ResultType right = std::move(results.back()); results.pop_back();
+				ResultType left = std::move(results.back()); results.pop_back();
+				results.push_back(function(node, &left, &right));
+			}
+			else if(node.left != NoNode)
+			{
+				ResultType left = std::move(results.back()); results.pop_back();
+				results.push_back(function(node, &left, nullptr));
+			}
+			else
+				results.push_back(function(node, nullptr, nullptr));
+		}
+		return std::move(results.back());
+	}
+	// Friend methods
+	friend std::ostream& operator<<(std::ostream&, const RegexAST&);
+
+private:
+	NodeIdType addNode(const Node&);
+};
+
+class RegexParseError: public std::invalid_argument
+{
+private:
+	size_t _position;
+
+public:
+	RegexParseError(const std::string& message, const size_t& position)
+	:std::invalid_argument(message + " at position " + std::to_string(position)), _position(position)
+	{}
+	size_t getPosition() const { return _position; }
+};
+
+// Single pass recursive descent parser. Concatenation can be written with <.> or left implicit.
+//   alternative   := concatenation ('|' concatenation)*
+//   concatenation := kleene ('.'? kleene)*
+//   kleene        := atom '*'*
+//   atom          := '(' alternative ')' | '#' | symbol
+class RegexParser
+{
+private:
+	const std::string& _input;
+	size_t _position;
+	RegexAST _ast;
+
+public:
+	static RegexAST parse(const std::string&);
+
+private:
+	RegexParser(const std::string& input):_input(input), _position(0), _ast() {}
+	RegexAST::NodeIdType parseAlternative();
+	RegexAST::NodeIdType parseConcatenation();
+	RegexAST::NodeIdType parseKleene();
+	RegexAST::NodeIdType parseAtom();
+	bool atEnd() const { return _position >= _input.size(); }
+	char peek() const { return _input[_position]; }
+	bool startsAtom() const;
+};
+
+} /* namespace Automata */
+
+#endif /* REGEXPARSER_H_ */
@@ -0,0 +1,92 @@
+#ifndef STATEBITSET_H_
+#define STATEBITSET_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+#include "Common.h"
+
+namespace Automata {
+
+// Dense set of states in [0, capacity). All operations work a whole word at a time,
+// so sets to be compared or merged must share the same capacity.
+class StateBitSet
+{
+public:
+	using WordType = std::uint64_t;
+	static constexpr size_t BitsPerWord = 64;
+
+private:
+	std::vector<WordType> _words;
+
+public:
+	StateBitSet() = default;
+	explicit StateBitSet(size_t capacity):_words((capacity + BitsPerWord - 1) / BitsPerWord, 0) {}
+	StateBitSet(size_t, const StateSetType&);
+	void insert(const StateType& state) { _words[state / BitsPerWord] |= WordType(1) << (state % BitsPerWord); }
+	bool contains(const StateType& state) const { return (_words[state / BitsPerWord] >> (state % BitsPerWord)) & 1; }
+	void clear() { std::fill(std::begin(_words), std::end(_words), 0); }
+	bool empty() const
+	{
+		WordType accumulator = 0;
+		for(const auto& word: _words)
+			accumulator |= word;
+		return accumulator == 0;
+	}
+	size_t count() const;
+	StateBitSet& operator|=(const StateBitSet& rhs)
+	{
+		WordType* words = _words.data();
+		const WordType* other = rhs._words.data();
+		for(size_t i = 0; i < _words.size(); i++)
+			words[i] |= other[i];
+		return *this;
+	}
+	bool intersects(const StateBitSet& rhs) const
+	{
+		WordType accumulator = 0;
+		for(size_t i = 0; i < _words.size(); i++)
+			accumulator |= _words[i] & rhs._words[i];
+		return accumulator != 0;
+	}
+	bool operator==(const StateBitSet& rhs) const { return _words == rhs._words; }
+	bool operator!=(const StateBitSet& rhs) const { return !operator==(rhs); }
+	bool operator<(const StateBitSet& rhs) const { return _words < rhs._words; }
+	size_t hash() const
+	{
+		std::uint64_t h = 0x9E3779B97F4A7C15ull;
+		for(const auto& word: _words)
+			h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+	template <class Function>
+	void forEach(Function function) const
+	{
+		for(size_t i = 0; i < _words.size(); i++)
+		{
+			WordType word = _words[i];
+			while(word)
+			{
+				function(static_cast<StateType>(i * BitsPerWord + __builtin_ctzll(word)));
+				word &= word - 1;
+			}
+		}
+	}
+	size_t getNumberOfWords() const { return _words.size(); }
+	const WordType* data() const { return _words.data(); }
+	WordType* data() { return _words.data(); }
+	StateSetType toStateSet() const;
+
+	struct Hash
+	{
+		size_t operator()(const StateBitSet& states) const { return states.hash(); }
+	};
+	// Friend methods
+	friend std::ostream& operator<<(std::ostream&, const StateBitSet&);
+};
+
+} /* namespace Automata */
+
+#endif /* STATEBITSET_H_ */
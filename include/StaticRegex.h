@@ -0,0 +1,466 @@
+#ifndef STATICREGEX_H_
+#define STATICREGEX_H_
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "Common.h"
+
+namespace Automata {
+
+// Compile time counterparts of RegexParser, Thompson, SymbolClasses, Powerset and Hopcroft,
+// over fixed capacity arrays so they run in constant evaluation. Capacities follow from the
+// pattern length, except for the number of DFA states. Errors are thrown, which turns them
+// into compile errors.
+namespace StaticRegexDetail {
+
+constexpr size_t length(const char* pattern)
+{
+	size_t n = 0;
+	while(pattern[n] != '\0')
+		n++;
+	return n;
+}
+
+constexpr int None = -1;
+
+template <size_t Capacity>
+using StateSet = std::array<std::uint64_t, (Capacity + 63) / 64>;
+
+template <size_t Capacity>
+constexpr bool contains(const StateSet<Capacity>& set, const int& state)
+{
+	return (set[state >> 6] >> (state & 63)) & 1;
+}
+
+template <size_t Capacity>
+constexpr void insert(StateSet<Capacity>& set, const int& state)
+{
+	set[state >> 6] |= std::uint64_t(1) << (state & 63);
+}
+
+template <size_t Capacity>
+constexpr bool equal(const StateSet<Capacity>& left, const StateSet<Capacity>& right)
+{
+	for(size_t i = 0; i < left.size(); i++)
+		if(left[i] != right[i])
+			return false;
+	return true;
+}
+
+// Thompson automaton, every state has one symbol edge or at most two epsilon edges
+template <size_t Capacity>
+struct NFA
+{
+	std::array<int, Capacity> symbol{};
+	std::array<int, Capacity> next{};
+	std::array<int, Capacity> epsilon1{};
+	std::array<int, Capacity> epsilon2{};
+	size_t numberOfStates = 0;
+	int initialState = None;
+	int finalState = None;
+
+	constexpr int addState()
+	{
+		if(numberOfStates == Capacity)
+			throw std::invalid_argument("Too many NFA states");
+		symbol[numberOfStates] = None;
+		next[numberOfStates] = None;
+		epsilon1[numberOfStates] = None;
+		epsilon2[numberOfStates] = None;
+		return static_cast<int>(numberOfStates++);
+	}
+	constexpr void addEpsilon(const int& from, const int& to)
+	{
+		if(epsilon1[from] == None)
+			epsilon1[from] = to;
+		else
+			epsilon2[from] = to;
+	}
+};
+
+struct Fragment
+{
+	int start;
+	int end;
+};
+
+// Same grammar as RegexParser, building Thompson fragments instead of an AST
+template <size_t Capacity>
+class Parser
+{
+private:
+	const char* _input;
+	size_t _length;
+	size_t _position;
+	NFA<Capacity> _nfa;
+
+public:
+	constexpr Parser(const char* input, const size_t& length):_input(input), _length(length), _position(0), _nfa() {}
+
+	constexpr NFA<Capacity> parse()
+	{
+		const Fragment fragment = parseAlternative();
+		if(_position != _length)
+			throw std::invalid_argument("Unexpected character in regex");
+		_nfa.initialState = fragment.start;
+		_nfa.finalState = fragment.end;
+		return _nfa;
+	}
+
+private:
+	constexpr bool startsAtom() const
+	{
+		const char c = _input[_position];
+		return c != '|' && c != ')' && c != '*' && c != '.';
+	}
+
+	constexpr Fragment parseAlternative()
+	{
+		Fragment left = parseConcatenation();
+		while(_position < _length && _input[_position] == '|')
+		{
+			_position++;
+			const Fragment right = parseConcatenation();
+			const Fragment result{_nfa.addState(), _nfa.addState()};
+			_nfa.addEpsilon(result.start, left.start);
+			_nfa.addEpsilon(result.start, right.start);
+			_nfa.addEpsilon(left.end, result.end);
+			_nfa.addEpsilon(right.end, result.end);
+			left = result;
+		}
+		return left;
+	}
+
+	constexpr Fragment parseConcatenation()
+	{
+		Fragment left = parseKleene();
+		while(_position < _length)
+		{
+			if(_input[_position] == '.')
+				_position++;
+			else if(!startsAtom())
+				break;
+			const Fragment right = parseKleene();
+			_nfa.addEpsilon(left.end, right.start);
+			left.end = right.end;
+		}
+		return left;
+	}
+
+	constexpr Fragment parseKleene()
+	{
+		Fragment child = parseAtom();
+		while(_position < _length && _input[_position] == '*')
+		{
+			_position++;
+			const Fragment result{_nfa.addState(), _nfa.addState()};
+			_nfa.addEpsilon(result.start, child.start);
+			_nfa.addEpsilon(result.start, result.end);
+			_nfa.addEpsilon(child.end, child.start);
+			_nfa.addEpsilon(child.end, result.end);
+			child = result;
+		}
+		return child;
+	}
+
+	constexpr Fragment parseAtom()
+	{
+		if(_position == _length)
+			throw std::invalid_argument("Unexpected end of regex");
+		const char c = _input[_position];
+		if(c == '(')
+		{
+			_position++;
+			const Fragment inner = parseAlternative();
+			if(_position == _length || _input[_position] != ')')
+				throw std::invalid_argument("Unbalanced ( in regex");
+			_position++;
+			return inner;
+		}
+		if(!startsAtom())
+			throw std::invalid_argument("Unexpected character in regex");
+		_position++;
+		const Fragment fragment{_nfa.addState(), _nfa.addState()};
+		if(c == EpsilonCharacter)
+			_nfa.addEpsilon(fragment.start, fragment.end);
+		else
+		{
+			_nfa.symbol[fragment.start] = static_cast<unsigned char>(c);
+			_nfa.next[fragment.start] = fragment.end;
+		}
+		return fragment;
+	}
+};
+
+template <size_t Capacity>
+constexpr StateSet<Capacity> closure(const NFA<Capacity>& nfa, const StateSet<Capacity>& states)
+{
+	StateSet<Capacity> result = states;
+	std::array<int, Capacity> pending{};
+	size_t numberOfPending = 0;
+	for(size_t state = 0; state < nfa.numberOfStates; state++)
+		if(contains<Capacity>(states, state))
+			pending[numberOfPending++] = state;
+	while(numberOfPending > 0)
+	{
+		const int state = pending[--numberOfPending];
+		for(const int target: {nfa.epsilon1[state], nfa.epsilon2[state]})
+			if(target != None && !contains<Capacity>(result, target))
+			{
+				insert<Capacity>(result, target);
+				pending[numberOfPending++] = target;
+			}
+	}
+	return result;
+}
+
+// Total DFA over byte classes. Bytes are in the same class when the same NFA states move
+// on them, class 0 holds the bytes no state moves on.
+template <size_t MaxStates, size_t MaxClasses>
+struct DFA
+{
+	std::array<std::uint8_t, 256> byteClasses{};
+	size_t numberOfClasses = 0;
+	std::array<std::array<int, MaxClasses>, MaxStates> table{};
+	std::array<bool, MaxStates> accepting{};
+	size_t numberOfStates = 0;
+	int deadState = None;
+};
+
+template <size_t Capacity, size_t MaxStates, size_t MaxClasses>
+constexpr DFA<MaxStates, MaxClasses> powerset(const NFA<Capacity>& nfa)
+{
+	DFA<MaxStates, MaxClasses> dfa;
+
+	std::array<StateSet<Capacity>, 256> movers{};
+	for(size_t state = 0; state < nfa.numberOfStates; state++)
+		if(nfa.symbol[state] != None)
+			insert<Capacity>(movers[nfa.symbol[state]], state);
+	std::array<int, MaxClasses> classByte{};
+	dfa.numberOfClasses = 1;
+	for(size_t byte = 0; byte < 256; byte++)
+	{
+		dfa.byteClasses[byte] = 0;
+		if(equal<Capacity>(movers[byte], StateSet<Capacity>{}))
+			continue;
+		size_t symbolClass = 1;
+		while(symbolClass < dfa.numberOfClasses && !equal<Capacity>(movers[byte], movers[classByte[symbolClass]]))
+			symbolClass++;
+		if(symbolClass == dfa.numberOfClasses)
+			classByte[dfa.numberOfClasses++] = byte;
+		dfa.byteClasses[byte] = symbolClass;
+	}
+
+	std::array<StateSet<Capacity>, MaxStates> subsets{};
+	StateSet<Capacity> initial{};
+	insert<Capacity>(initial, nfa.initialState);
+	subsets[0] = closure(nfa, initial);
+	dfa.numberOfStates = 1;
+	for(size_t id = 0; id < dfa.numberOfStates; id++)
+	{
+		dfa.accepting[id] = contains<Capacity>(subsets[id], nfa.finalState);
+		for(size_t symbolClass = 0; symbolClass < dfa.numberOfClasses; symbolClass++)
+		{
+			StateSet<Capacity> moved{};
+			if(symbolClass != 0)
+				for(size_t state = 0; state < nfa.numberOfStates; state++)
+					if(contains<Capacity>(subsets[id], state) && nfa.symbol[state] == classByte[symbolClass])
+						insert<Capacity>(moved, nfa.next[state]);
+			const StateSet<Capacity> target = closure(nfa, moved);
+
+			size_t targetId = 0;
+			while(targetId < dfa.numberOfStates && !equal<Capacity>(subsets[targetId], target))
+				targetId++;
+			if(targetId == dfa.numberOfStates)
+			{
+				if(dfa.numberOfStates == MaxStates)
+					throw std::invalid_argument("Too many DFA states, raise MaxDFAStates");
+				subsets[dfa.numberOfStates++] = target;
+			}
+			dfa.table[id][symbolClass] = targetId;
+		}
+	}
+	return dfa;
+}
+
+// Moore refinement as in Hopcroft::applyParallel, then states are numbered breadth first
+// from the initial one, like Hopcroft::apply does
+template <size_t MaxStates, size_t MaxClasses>
+constexpr DFA<MaxStates, MaxClasses> minimize(const DFA<MaxStates, MaxClasses>& dfa)
+{
+	std::array<int, MaxStates> block{};
+	for(size_t state = 0; state < dfa.numberOfStates; state++)
+		block[state] = dfa.accepting[state] ? 1 : 0;
+
+	size_t numberOfBlocks = 0;
+	for(;;)
+	{
+		// A state joins the block of the first earlier state with the same signature
+		std::array<int, MaxStates> refined{};
+		std::array<int, MaxStates> representative{};
+		size_t numberOfRefined = 0;
+		for(size_t state = 0; state < dfa.numberOfStates; state++)
+		{
+			size_t candidate = 0;
+			for(; candidate < numberOfRefined; candidate++)
+			{
+				const int other = representative[candidate];
+				bool same = block[state] == block[other];
+				for(size_t symbolClass = 0; same && symbolClass < dfa.numberOfClasses; symbolClass++)
+					same = block[dfa.table[state][symbolClass]] == block[dfa.table[other][symbolClass]];
+				if(same)
+					break;
+			}
+			if(candidate == numberOfRefined)
+				representative[numberOfRefined++] = state;
+			refined[state] = candidate;
+		}
+		block = refined;
+		if(numberOfRefined == numberOfBlocks)
+			break;
+		numberOfBlocks = numberOfRefined;
+	}
+
+	DFA<MaxStates, MaxClasses> minimal;
+	minimal.byteClasses = dfa.byteClasses;
+	minimal.numberOfClasses = dfa.numberOfClasses;
+	std::array<int, MaxStates> numbering{};
+	std::array<int, MaxStates> order{};
+	for(size_t i = 0; i < numberOfBlocks; i++)
+		numbering[i] = None;
+	numbering[block[0]] = 0;
+	order[0] = 0;
+	minimal.numberOfStates = 1;
+	for(size_t i = 0; i < minimal.numberOfStates; i++)
+	{
+		const int state = order[i];
+		minimal.accepting[i] = dfa.accepting[state];
+		bool dead = !dfa.accepting[state];
+		for(size_t symbolClass = 0; symbolClass < dfa.numberOfClasses; symbolClass++)
+		{
+			const int target = dfa.table[state][symbolClass];
+			if(numbering[block[target]] == None)
+			{
+				numbering[block[target]] = minimal.numberOfStates;
+				order[minimal.numberOfStates++] = target;
+			}
+			minimal.table[i][symbolClass] = numbering[block[target]];
+			dead = dead && block[target] == block[state];
+		}
+		if(dead)
+			minimal.deadState = i;
+	}
+
+	// Classes told apart only by states that were merged end up with equal columns
+	std::array<int, MaxClasses> classOf{};
+	size_t numberOfClasses = 0;
+	for(size_t symbolClass = 0; symbolClass < minimal.numberOfClasses; symbolClass++)
+	{
+		size_t candidate = 0;
+		for(; candidate < numberOfClasses; candidate++)
+		{
+			bool same = true;
+			for(size_t state = 0; same && state < minimal.numberOfStates; state++)
+				same = minimal.table[state][candidate] == minimal.table[state][symbolClass];
+			if(same)
+				break;
+		}
+		if(candidate == numberOfClasses)
+		{
+			for(size_t state = 0; state < minimal.numberOfStates; state++)
+				minimal.table[state][numberOfClasses] = minimal.table[state][symbolClass];
+			numberOfClasses++;
+		}
+		classOf[symbolClass] = candidate;
+	}
+	for(size_t byte = 0; byte < 256; byte++)
+		minimal.byteClasses[byte] = classOf[minimal.byteClasses[byte]];
+	minimal.numberOfClasses = numberOfClasses;
+	return minimal;
+}
+
+template <size_t MaxDFAStates>
+struct Compiler
+{
+	template <size_t Length>
+	static constexpr auto apply(const char* pattern)
+	{
+		constexpr size_t Capacity = 2 * Length + 2;
+		constexpr size_t MaxClasses = (Length < 255 ? Length : 255) + 1;
+		return minimize(powerset<Capacity, MaxDFAStates, MaxClasses>(Parser<Capacity>(pattern, Length).parse()));
+	}
+};
+
+// Copies into arrays sized by the actual state and class counts
+template <class StateType, size_t NumberOfStates, size_t NumberOfClasses, size_t MaxStates, size_t MaxClasses>
+constexpr auto shrinkTable(const DFA<MaxStates, MaxClasses>& dfa)
+{
+	std::array<std::array<StateType, NumberOfClasses>, NumberOfStates> table{};
+	for(size_t state = 0; state < NumberOfStates; state++)
+		for(size_t symbolClass = 0; symbolClass < NumberOfClasses; symbolClass++)
+			table[state][symbolClass] = dfa.table[state][symbolClass];
+	return table;
+}
+
+template <size_t NumberOfStates, size_t MaxStates, size_t MaxClasses>
+constexpr auto shrinkAccepting(const DFA<MaxStates, MaxClasses>& dfa)
+{
+	std::array<bool, NumberOfStates> accepting{};
+	for(size_t state = 0; state < NumberOfStates; state++)
+		accepting[state] = dfa.accepting[state];
+	return accepting;
+}
+
+} /* namespace StaticRegexDetail */
+
+// Minimal DFA of a regex built during compilation, with the state count and the number of
+// byte classes as constants and match usable in constant expressions. The pattern has to
+// be a constexpr char array with static storage:
+//   static constexpr char abb[] = "(a|b)*abb";
+//   static_assert(StaticRegex<abb>::match("babb"));
+template <const char* Pattern, size_t MaxDFAStates = 256>
+class StaticRegex
+{
+private:
+	static constexpr auto _dfa = StaticRegexDetail::Compiler<MaxDFAStates>::template apply<StaticRegexDetail::length(Pattern)>(Pattern);
+
+public:
+	static constexpr size_t NumberOfStates = _dfa.numberOfStates;
+	static constexpr size_t NumberOfClasses = _dfa.numberOfClasses;
+	using StateType = std::conditional_t<NumberOfStates <= 0x100, std::uint8_t, std::uint16_t>;
+	static constexpr StateType InitialState = 0;
+	// NumberOfStates when every state can still reach an accepting one
+	static constexpr StateType DeadState = _dfa.deadState == StaticRegexDetail::None ? NumberOfStates : _dfa.deadState;
+
+private:
+	static constexpr std::array<std::uint8_t, 256> _byteClasses = _dfa.byteClasses;
+	static constexpr auto _table = StaticRegexDetail::shrinkTable<StateType, NumberOfStates, NumberOfClasses>(_dfa);
+	static constexpr auto _accepting = StaticRegexDetail::shrinkAccepting<NumberOfStates>(_dfa);
+
+public:
+	StaticRegex() = delete;
+	static constexpr StateType next(const StateType& state, const unsigned char& byte)
+	{
+		return _table[state][_byteClasses[byte]];
+	}
+	static constexpr bool isAccepting(const StateType& state) { return _accepting[state]; }
+	static constexpr bool match(std::string_view input)
+	{
+		StateType state = InitialState;
+		for(const char c: input)
+		{
+			state = next(state, static_cast<unsigned char>(c));
+			if(state == DeadState)
+				return false;
+		}
+		return isAccepting(state);
+	}
+};
+
+} /* namespace Automata */
+
+#endif /* STATICREGEX_H_ */
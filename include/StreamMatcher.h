@@ -0,0 +1,39 @@
+#ifndef STREAMMATCHER_H_
+#define STREAMMATCHER_H_
+
+#include <string>
+
+#include "Common.h"
+#include "DFA.h"
+
+namespace Automata {
+
+// Runs a DenseDFA over input that arrives in chunks. The whole match state is a single
+// DFA state, it can be saved with getState and resumed later, even on another matcher
+// over the same DenseDFA. Once the dead state is reached the rest of the input is skipped.
+class StreamMatcher
+{
+public:
+	using IndexType = DenseDFA::IndexType;
+
+protected:
+	const DenseDFA& _dfa;
+	IndexType _state;
+
+public:
+	StreamMatcher(const DenseDFA&);
+	// Only a reference to the DFA is kept, so it can not be a temporary
+	StreamMatcher(DenseDFA&&) = delete;
+	void feed(const char*, size_t);
+	void feed(const std::string& chunk) { feed(chunk.data(), chunk.size()); }
+	void feedFile(const std::string&);
+	bool finish() const { return _dfa.isAccepting(_state); }
+	bool isDead() const { return _state == _dfa.getDeadState(); }
+	void reset() { _state = _dfa.getInitialState(); }
+	IndexType getState() const { return _state; }
+	void setState(const IndexType&);
+};
+
+} /* namespace Automata */
+
+#endif /* STREAMMATCHER_H_ */
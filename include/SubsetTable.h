@@ -0,0 +1,56 @@
+#ifndef SUBSETTABLE_H_
+#define SUBSETTABLE_H_
+
+#include <vector>
+#include <utility>
+
+#include "Common.h"
+#include "StateBitSet.h"
+
+namespace Automata {
+
+// Interns subsets of NFA states into dense integer ids. Every subset is hashed once and
+// stored in a single arena, so callers only keep and compare ids.
+class SubsetTable
+{
+public:
+	using IdType = StateType;
+	using WordType = StateBitSet::WordType;
+
+private:
+	static constexpr IdType EmptyBucket = static_cast<IdType>(-1);
+	static constexpr size_t InitialBuckets = 16;
+
+	size_t _numberOfStates;
+	size_t _wordsPerSubset;
+	std::vector<WordType> _arena;
+	std::vector<size_t> _hashes;
+	std::vector<IdType> _buckets;
+
+public:
+	SubsetTable(size_t);
+	SubsetTable(const SubsetTable&) = delete;
+	SubsetTable& operator=(const SubsetTable&) = delete;
+	std::pair<IdType, bool> intern(const StateBitSet&);
+	size_t size() const { return _hashes.size(); }
+	size_t getNumberOfStates() const { return _numberOfStates; }
+	const WordType* getWords(const IdType& id) const { return _arena.data() + id * _wordsPerSubset; }
+	StateBitSet getSubset(const IdType&) const;
+	void getSubset(const IdType&, StateBitSet&) const;
+	bool contains(const IdType& id, const StateType& state) const
+	{
+		return (getWords(id)[state / StateBitSet::BitsPerWord] >> (state % StateBitSet::BitsPerWord)) & 1;
+	}
+	// Bytes held by the interned subsets, not the capacity reserved for more
+	size_t getMemoryUsage() const;
+	// Forgets every subset, the bucket array shrinks back to its initial size
+	void clear();
+
+private:
+	void grow();
+	bool equals(const IdType&, const WordType*) const;
+};
+
+} /* namespace Automata */
+
+#endif /* SUBSETTABLE_H_ */
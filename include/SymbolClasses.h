@@ -0,0 +1,44 @@
+#ifndef SYMBOLCLASSES_H_
+#define SYMBOLCLASSES_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include "Common.h"
+#include "NFA.h"
+#include "DFA.h"
+
+namespace Automata {
+
+// Partition of an automaton alphabet into classes of symbols that have the same
+// transitions from every state. Algorithms only need to look at one symbol per class.
+// Symbols are handled by id; classes are numbered, and their symbols sorted, by name.
+class SymbolClasses
+{
+public:
+	using ClassType = unsigned int;
+
+private:
+	std::vector<std::vector<SymbolIdType>> _classes;
+	std::unordered_map<SymbolIdType, ClassType> _classOf;
+
+public:
+	SymbolClasses(const NFA&);
+	SymbolClasses(const DFA&);
+	size_t getNumberOfClasses() const { return _classes.size(); }
+	const std::vector<SymbolIdType>& getSymbolIds(const ClassType& symbolClass) const { return _classes.at(symbolClass); }
+	SymbolIdType getRepresentativeId(const ClassType& symbolClass) const { return _classes.at(symbolClass).front(); }
+	ClassType getClass(const SymbolIdType&) const;
+	SymbolSetType getSymbols(const ClassType&) const;
+	SymbolType getRepresentative(const ClassType& symbolClass) const { return SymbolTable::getSymbol(getRepresentativeId(symbolClass)); }
+	ClassType getClass(const SymbolType&) const;
+
+private:
+	template <class AutomatonType> void compute(const AutomatonType&);
+	static const StateSetType& getTargets(const NFA&, const StateType&, const SymbolIdType&);
+	static const StateSetType& getTargets(const DFA&, const StateType&, const SymbolIdType&);
+};
+
+} /* namespace Automata */
+
+#endif /* SYMBOLCLASSES_H_ */
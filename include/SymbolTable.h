@@ -0,0 +1,41 @@
+#ifndef SYMBOLTABLE_H_
+#define SYMBOLTABLE_H_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+#include "Common.h"
+
+namespace Automata {
+
+// Process wide interning of symbols into a compact integer id space. A one byte symbol
+// is its own byte value, so matching never needs a lookup; longer symbols get ids from
+// FirstInternedId on. Every automaton shares this table.
+class SymbolTable
+{
+public:
+	static constexpr SymbolIdType FirstInternedId = 256;
+
+private:
+	mutable std::mutex _mutex;
+	std::unordered_map<SymbolType, SymbolIdType> _ids;
+	std::deque<SymbolType> _symbols;
+
+	SymbolTable() = default;
+	static SymbolTable& getInstance();
+
+public:
+	SymbolTable(const SymbolTable&) = delete;
+	SymbolTable& operator=(const SymbolTable&) = delete;
+	static SymbolIdType intern(const SymbolType&);
+	static bool find(const SymbolType&, SymbolIdType&);
+	static SymbolType getSymbol(const SymbolIdType&);
+	static bool isByte(const SymbolIdType& id) { return id < FirstInternedId; }
+};
+
+} /* namespace Automata */
+
+#endif /* SYMBOLTABLE_H_ */
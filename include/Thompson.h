@@ -3,9 +3,11 @@
 
 #include <string>
 #include <stack>
+#include <vector>
 
 #include <Common.h>
 #include <NFA.h>
+#include <RegexParser.h>
 
 namespace Automata {
 
@@ -37,12 +39,63 @@ public:
 	static Automata::NFA apply(const NFA&);
 };
 
-void copyTransitions(NFABuilder<std::string>&, const NFA&, const std::string& = "");
+// Accepts the mirror image of the language, used to scan back to where a match starts
+class Reverse
+{
+public:
+	Reverse() = delete;
+	static Automata::NFA apply(const NFA&);
+};
+
+void copyTransitions(NFABuilder<StateType>&, const NFA&, const StateType& = 0);
+
+// Fragments are appended to one growing arena. A fragment is a start state plus a list of
+// dangling edges that get their target patched in place once the next fragment is known,
+// so operands are never copied.
+class ThompsonArena
+{
+public:
+	struct Fragment
+	{
+		StateType start;
+		size_t danglingHead;
+		size_t danglingTail;
+	};
+
+private:
+	static constexpr StateType Dangling = static_cast<StateType>(-1);
+	struct Edge
+	{
+		StateType source;
+		SymbolIdType symbol;
+		StateType target;
+		size_t nextDangling;
+	};
+
+	std::vector<Edge> _edges;
+	StateType _numberOfStates;
+
+public:
+	ThompsonArena():_edges(), _numberOfStates(0) {}
+	ThompsonArena(const ThompsonArena&) = delete;
+	ThompsonArena& operator=(const ThompsonArena&) = delete;
+	Fragment symbol(const SymbolIdType&);
+	Fragment concatenation(const Fragment&, const Fragment&);
+	Fragment alternative(const Fragment&, const Fragment&);
+	Fragment kleene(const Fragment&);
+	Automata::NFA build(const Fragment&);
+
+private:
+	StateType addState() { return _numberOfStates++; }
+	size_t addEdge(const StateType&, const SymbolIdType&, const StateType& = Dangling);
+	void patch(const Fragment&, const StateType&);
+};
 
 class Thompson {
 public:
 	Thompson() = delete;
 	static Automata::NFA apply(const std::string&);
+	static Automata::NFA apply(const RegexAST&);
 	static bool isConcatenationOperator(const char& c){return c == '.';}
 	static bool isAlternativeOperator(const char& c){return c == '|';}
 	static bool isKleeneOperator(const char& c){return c == '*';}
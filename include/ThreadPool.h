@@ -0,0 +1,49 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Automata {
+
+// Fixed set of worker threads for fork-join loops. run hands task indices out through an
+// atomic counter, the calling thread takes tasks too and returns once all of them are
+// done. The first exception thrown by a task is rethrown by run.
+class ThreadPool
+{
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _runMutex;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	const std::function<void(size_t)>* _task;
+	size_t _numberOfTasks;
+	std::atomic<size_t> _nextTask;
+	size_t _busyWorkers;
+	size_t _generation;
+	bool _stopping;
+	std::exception_ptr _error;
+
+public:
+	ThreadPool(const size_t& numberOfThreads = defaultNumberOfThreads());
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool();
+	size_t size() const { return _workers.size() + 1; }
+	void run(const size_t&, const std::function<void(size_t)>&);
+	static size_t defaultNumberOfThreads();
+
+private:
+	void work();
+	void runTasks();
+};
+
+} /* namespace Automata */
+
+#endif /* THREADPOOL_H_ */
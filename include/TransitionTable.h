@@ -9,6 +9,7 @@
 #include <iomanip>
 
 #include "Common.h"
+#include "SymbolTable.h"
 
 namespace Automata
 {
@@ -17,11 +18,14 @@ class TransitionTable
 {
 private:
 	using TableType = std::vector<std::vector<StateSetType>>;
-	using SymbolToIndexType = std::map<SymbolType, size_t>;
+	using SymbolToColumnType = std::vector<size_t>;
+
+	static constexpr size_t NoColumn = static_cast<size_t>(-1);
 
 	TableType _table;
 	SymbolSetType _symbols;
-	SymbolToIndexType _symbolsMapping;
+	SymbolToColumnType _columnOf;
+	std::vector<SymbolIdType> _columnSymbols;
 
 public:
 	TransitionTable();
@@ -29,11 +33,18 @@ public:
 	TransitionTable& operator=(TransitionTable);
 	StateType addState();
 	void addSymbol(const SymbolType&);
+	void addSymbol(const SymbolIdType&);
 	void addTransition(const StateType&, const SymbolType&, const StateType&);
+	void addTransition(const StateType&, const SymbolIdType&, const StateType&);
 	const StateSetType& getTransition(const StateType&, const SymbolType&) const;
 	StateSetType& getTransition(const StateType&, const SymbolType&);
+	const StateSetType& getTransition(const StateType&, const SymbolIdType&) const;
 	bool isValidState(const StateType&) const;
 	bool isValidSymbol(const SymbolType&) const;
+	bool isValidSymbol(const SymbolIdType&) const;
+	size_t getNumberOfStates() const;
+	// Ids of the table's symbols in column order, Epsilon first
+	const std::vector<SymbolIdType>& getSymbolIds() const { return _columnSymbols; }
 	~TransitionTable() = default;
 	// Iterators
 	class StateIterator
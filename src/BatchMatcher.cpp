@@ -0,0 +1,93 @@
+#include "BatchMatcher.h"
+
+#include <algorithm>
+
+namespace Automata {
+
+BatchMatcher::BatchMatcher(const DenseDFA& dfa)
+:_dfa(dfa)
+{
+}
+
+void BatchMatcher::run(const std::string* inputs, size_t numberOfInputs, std::uint64_t* accepted) const
+{
+	const IndexType* const table = _dfa.getTable().data();
+	const DenseDFA::ClassType* const byteClasses = _dfa.getByteClasses().data();
+	const size_t numberOfClasses = _dfa.getNumberOfClasses();
+
+	std::fill(accepted, accepted + (numberOfInputs + 63) / 64, 0);
+
+	// Lanes are kept as parallel arrays so the inner loop is plain indexed loads
+	const unsigned char* next[Lanes];
+	size_t remaining[Lanes];
+	size_t input[Lanes];
+	IndexType state[Lanes];
+	size_t activeLanes = 0;
+	size_t nextInput = 0;
+	const auto load = [&](const size_t& lane)
+	{
+		next[lane] = reinterpret_cast<const unsigned char*>(inputs[nextInput].data());
+		remaining[lane] = inputs[nextInput].size();
+		input[lane] = nextInput++;
+		state[lane] = _dfa.getInitialState();
+#if defined(__GNUC__)
+		// Bytes of an input a full round of lanes ahead, they usually live elsewhere on the heap
+		if(nextInput + Lanes < numberOfInputs)
+			__builtin_prefetch(inputs[nextInput + Lanes].data());
+#endif
+	};
+
+	for(; activeLanes < Lanes && nextInput < numberOfInputs; activeLanes++)
+		load(activeLanes);
+
+	while(true)
+	{
+		// Finished lanes report and take the next input, or are retired by moving the last lane in
+		size_t lane = 0;
+		while(lane < activeLanes)
+		{
+			if(remaining[lane] > 0)
+			{
+				lane++;
+				continue;
+			}
+			if(_dfa.isAccepting(state[lane]))
+				accepted[input[lane] / 64] |= std::uint64_t(1) << (input[lane] % 64);
+			if(nextInput < numberOfInputs)
+				load(lane);
+			else
+			{
+				activeLanes--;
+				next[lane] = next[activeLanes];
+				remaining[lane] = remaining[activeLanes];
+				input[lane] = input[activeLanes];
+				state[lane] = state[activeLanes];
+			}
+		}
+		if(activeLanes == 0)
+			break;
+
+		// Every lane can take this many bytes without a bounds check
+		size_t steps = remaining[0];
+		for(lane = 1; lane < activeLanes; lane++)
+			steps = std::min(steps, remaining[lane]);
+
+		for(size_t step = 0; step < steps; step++)
+			for(lane = 0; lane < activeLanes; lane++)
+				state[lane] = table[static_cast<size_t>(state[lane]) * numberOfClasses + byteClasses[next[lane][step]]];
+		for(lane = 0; lane < activeLanes; lane++)
+		{
+			next[lane] += steps;
+			remaining[lane] -= steps;
+		}
+	}
+}
+
+std::vector<std::uint64_t> BatchMatcher::run(const std::vector<std::string>& inputs) const
+{
+	std::vector<std::uint64_t> accepted((inputs.size() + 63) / 64);
+	run(inputs.data(), inputs.size(), accepted.data());
+	return accepted;
+}
+
+} /* namespace Automata */
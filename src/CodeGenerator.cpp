@@ -0,0 +1,160 @@
+#include "CodeGenerator.h"
+
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+namespace Automata {
+
+void CodeGenerator::emitHeader(const std::vector<Matcher>& matchers, std::ostream& os)
+{
+	os << "// Generated by DFACodegen, do not edit\n"
+	   << "#pragma once\n\n"
+	   << "#include <cstddef>\n"
+	   << "#include <string_view>\n";
+	for(const auto& matcher: matchers)
+	{
+		checkName(matcher.name);
+		os << "\n// " << quote(matcher.regex) << "\n"
+		   << "bool " << matcher.name << "(const char* input, std::size_t length);\n\n"
+		   << "inline bool " << matcher.name << "(std::string_view input)\n"
+		   << "{\n"
+		   << "\treturn " << matcher.name << "(input.data(), input.size());\n"
+		   << "}\n";
+	}
+}
+
+void CodeGenerator::emitSource(const std::vector<Matcher>& matchers, const Style& style, std::ostream& os)
+{
+	os << "// Generated by DFACodegen, do not edit\n"
+	   << "#include <cstddef>\n"
+	   << "#include <cstdint>\n";
+	for(const auto& matcher: matchers)
+	{
+		checkName(matcher.name);
+		os << "\n// " << quote(matcher.regex) << "\n"
+		   << "bool " << matcher.name << "(const char* input, std::size_t length)\n"
+		   << "{\n";
+		if(style == Style::Switch)
+			emitSwitch(matcher.dfa, os);
+		else
+			emitTable(matcher.dfa, os);
+		os << "}\n";
+	}
+}
+
+void CodeGenerator::checkName(const std::string& name)
+{
+	bool valid = !name.empty() && !std::isdigit(static_cast<unsigned char>(name[0]));
+	for(const auto& c: name)
+		valid = valid && (std::isalnum(static_cast<unsigned char>(c)) || c == '_');
+	if(!valid)
+		throw std::invalid_argument("Invalid matcher name " + name);
+}
+
+// Escaped like a string literal, so a backslash at the end can not splice the next line into the comment
+std::string CodeGenerator::quote(const std::string& regex)
+{
+	static const char* const digits = "0123456789abcdef";
+	std::string quoted = "\"";
+	for(const auto& c: regex)
+	{
+		const unsigned char byte = static_cast<unsigned char>(c);
+		if(c == '\\' || c == '"')
+			quoted += std::string("\\") + c;
+		else if(std::isprint(byte))
+			quoted += c;
+		else
+			quoted += std::string("\\x") + digits[byte >> 4] + digits[byte & 15];
+	}
+	return quoted + "\"";
+}
+
+void CodeGenerator::emitSwitch(const DenseDFA& dfa, std::ostream& os)
+{
+	const DenseDFA::IndexType dead = dfa.getDeadState();
+
+	os << "\tconst unsigned char* p = reinterpret_cast<const unsigned char*>(input);\n"
+	   << "\tconst unsigned char* const end = p + length;\n";
+	if(dfa.getInitialState() == dead)
+	{
+		os << "\treturn false;\n";
+		return;
+	}
+	os << "\tgoto s" << dfa.getInitialState() << ";\n";
+
+	for(DenseDFA::IndexType state = 0; state < dfa.getNumberOfStates(); state++)
+	{
+		if(state == dead)
+			continue;
+
+		// Bytes grouped by target, the most common target becomes the default
+		std::map<DenseDFA::IndexType, std::vector<unsigned char>> bytesTo;
+		for(size_t byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+			bytesTo[dfa.next(state, static_cast<unsigned char>(byte))].push_back(static_cast<unsigned char>(byte));
+		DenseDFA::IndexType defaultTarget = bytesTo.begin()->first;
+		for(const auto& entry: bytesTo)
+			if(entry.second.size() > bytesTo[defaultTarget].size())
+				defaultTarget = entry.first;
+
+		os << "s" << state << ":\n"
+		   << "\tif(p == end)\n"
+		   << "\t\treturn " << (dfa.isAccepting(state) ? "true" : "false") << ";\n"
+		   << "\tswitch(*p++)\n"
+		   << "\t{\n";
+		for(const auto& entry: bytesTo)
+		{
+			if(entry.first == defaultTarget)
+				continue;
+			os << "\t";
+			for(const auto& byte: entry.second)
+				os << (&byte == &entry.second.front() ? "" : " ") << "case " << byteLiteral(byte) << ":";
+			os << "\n\t\t" << (entry.first == dead ? std::string("return false") : "goto s" + std::to_string(entry.first)) << ";\n";
+		}
+		os << "\tdefault:\n"
+		   << "\t\t" << (defaultTarget == dead ? std::string("return false") : "goto s" + std::to_string(defaultTarget)) << ";\n"
+		   << "\t}\n";
+	}
+}
+
+void CodeGenerator::emitTable(const DenseDFA& dfa, std::ostream& os)
+{
+	const size_t numberOfStates = dfa.getNumberOfStates();
+	const std::string stateType = numberOfStates <= 0x100 ? "std::uint8_t" : numberOfStates <= 0x10000 ? "std::uint16_t" : "std::uint32_t";
+
+	os << "\tstatic const std::uint8_t classes[256] = {";
+	for(size_t byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+		os << (byte % 32 == 0 ? "\n\t\t" : " ") << static_cast<unsigned>(dfa.getByteClasses()[byte]) << ",";
+	os << "\n\t};\n";
+
+	os << "\tstatic const " << stateType << " table[" << numberOfStates << "][" << dfa.getNumberOfClasses() << "] = {\n";
+	for(DenseDFA::IndexType state = 0; state < numberOfStates; state++)
+	{
+		os << "\t\t{";
+		for(size_t symbolClass = 0; symbolClass < dfa.getNumberOfClasses(); symbolClass++)
+			os << (symbolClass == 0 ? "" : ", ") << dfa.getTable()[state * dfa.getNumberOfClasses() + symbolClass];
+		os << "},\n";
+	}
+	os << "\t};\n";
+
+	os << "\tstatic const bool accepting[" << numberOfStates << "] = {";
+	for(DenseDFA::IndexType state = 0; state < numberOfStates; state++)
+		os << (state % 32 == 0 ? "\n\t\t" : " ") << (dfa.isAccepting(state) ? "true" : "false") << ",";
+	os << "\n\t};\n";
+
+	os << "\tconst unsigned char* p = reinterpret_cast<const unsigned char*>(input);\n"
+	   << "\tconst unsigned char* const end = p + length;\n"
+	   << "\t" << stateType << " state = " << dfa.getInitialState() << ";\n"
+	   << "\twhile(p != end && state != " << dfa.getDeadState() << ")\n"
+	   << "\t\tstate = table[state][classes[*p++]];\n"
+	   << "\treturn accepting[state];\n";
+}
+
+std::string CodeGenerator::byteLiteral(const unsigned char& byte)
+{
+	if(std::isalnum(byte))
+		return std::string("'") + static_cast<char>(byte) + "'";
+	return std::to_string(byte);
+}
+
+} /* namespace Automata */
@@ -1,13 +1,23 @@
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include "Hopcroft.h"
-#include "SimpleAlgorithm.h"
+#include "RegexParser.h"
+#include "RegexOptimizer.h"
 #include "Powerset.h"
 #include "Thompson.h"
+#include "DFASearcher.h"
+#include "RegexCache.h"
 #include "DFA.h"
 
 const std::string exitToken = "$";
 
+// Minimal DFAs of the expressions already entered, equivalent expressions share one
+Automata::RegexCache regexCache;
+// Their searchers, keyed by the postfix form of the optimized expression like regexCache
+std::unordered_map<std::string, std::shared_ptr<const Automata::DFASearcher>> searcherCache;
+
 void printIntroduction()
 {
 	//std::string input = "(a|b)*.a.b.b";
@@ -26,7 +36,7 @@ void printIntroduction()
 	std::cout << std::endl;
 	std::cout << "Some observations:" << std::endl;
 	std::cout << "Alphabet will be calculated from the input" << std::endl;
-	std::cout << "The concatenation operator is *explicitly* symbolized with <.>" << std::endl;
+	std::cout << "The concatenation operator <.> may be written or left implicit, ab is a.b" << std::endl;
 	std::cout << "The string <" << exitToken << "> must not belong to the alphabet" << std::endl;
 	std::cout << std::endl;
 }
@@ -36,9 +46,9 @@ void printConclution()
 	std::cout << "Exiting..." << std::endl;
 }
 
-void testDFA(const Automata::DFA& dfa)
+void testDFA(const Automata::DFA& dfa, const Automata::DFASearcher& searcher, const Automata::Prefilter& prefilter)
 {
-	Automata::DFARunner runner(dfa);
+	Automata::DFARunner runner(dfa, prefilter);
 
 	std::string input;
 	do
@@ -53,6 +63,11 @@ void testDFA(const Automata::DFA& dfa)
 				std::cout << "Input <" << input << "> acepted." << std::endl;
 			else
 				std::cout << "Input <" << input << "> rejected." << std::endl;
+
+			std::cout << "Matches inside <" << input << ">:";
+			for(const auto& match: searcher.findAll(input))
+				std::cout << " [" << match.begin << ", " << match.end << ")";
+			std::cout << std::endl;
 		}
 
 	}while(input != exitToken);
@@ -69,19 +84,49 @@ bool proccessACase()
 
 	std::cout << "Input: " << input << std::endl;
 
-	const auto postfixInput = ShuntingYard::SimpleAlgorithm::apply(input);
-	std::cout << "Postfix Expression: " << postfixInput << std::endl;
+	Automata::RegexAST regex;
+	try
+	{
+		regex = Automata::RegexParser::parse(input);
+	}
+	catch(const Automata::RegexParseError& e)
+	{
+		std::cout << "Invalid RE: " << e.what() << std::endl;
+		return true;
+	}
+	std::cout << "Postfix Expression: " << regex << std::endl;
+
+	regex = Automata::RegexOptimizer::apply(regex);
+	std::cout << "Optimized Expression: " << regex << std::endl;
+
+	const Automata::Prefilter prefilter(regex);
+	std::cout << "Required literals: prefix <" << prefilter.getPrefix() << ">, suffix <" << prefilter.getSuffix()
+			<< ">, factor <" << prefilter.getFactor() << ">" << std::endl;
+
+	// The expression is already optimized, so its postfix form is the cache key
+	const std::string key = Automata::to_string(regex);
+	Automata::RegexCache::DFAPointer minDfa = regexCache.find(regex);
+	auto searcher = searcherCache.find(key);
+	if(minDfa && searcher != std::end(searcherCache))
+		std::cout << "Minimal DFA found in cache: " << std::endl << *minDfa << std::endl;
+	else
+	{
+		const auto nfa = Automata::Thompson::apply(regex);
+		std::cout << "Resulting NFA from Thompson's Construction: " << std::endl << nfa << std::endl;
 
-	const auto nfa = Automata::Thompson::apply(postfixInput);
-	std::cout << "Resulting NFA from Thompson's Construction: " << std::endl << nfa << std::endl;
+		const auto dfa = Automata::Powerset::apply(nfa);
+		std::cout << "Resulting DFA from Subset Construction: " << std::endl << dfa << std::endl;
 
-	const auto dfa = Automata::Powerset::apply(nfa);
-	std::cout << "Resulting DFA from Subset Construction: " << std::endl << dfa << std::endl;
+		minDfa = regexCache.insert(regex, Automata::Hopcroft::apply(dfa));
+		std::cout << "Resulting Minimal DFA from Hopcroft's Algorithm: " << std::endl << *minDfa << std::endl;
 
-	const auto minDfa = Automata::Hopcroft::apply(dfa);
-	std::cout << "Resulting Minimal DFA from Hopcroft's Algorithm: " << std::endl << minDfa << std::endl;
+		searcherCache[key] = std::make_shared<const Automata::DFASearcher>(*minDfa,
+				Automata::Hopcroft::apply(Automata::Powerset::applyUnanchored(nfa)),
+				Automata::Hopcroft::apply(Automata::Powerset::apply(Automata::Reverse::apply(nfa))), prefilter);
+		searcher = searcherCache.find(key);
+	}
 
-	testDFA(minDfa);
+	testDFA(*minDfa, *searcher->second, prefilter);
 
 	return true;
 }
@@ -0,0 +1,31 @@
+#include "ConcurrentSubsetTable.h"
+
+#include <stdexcept>
+
+namespace Automata {
+
+ConcurrentSubsetTable::ConcurrentSubsetTable(size_t numberOfStates, size_t numberOfShards)
+:_shards(), _size(0)
+{
+	if(numberOfShards == 0)
+		throw std::invalid_argument("At least one shard is needed");
+	for(size_t i = 0; i < numberOfShards; i++)
+		_shards.emplace_back(new Shard(numberOfStates));
+}
+
+std::pair<ConcurrentSubsetTable::IdType, bool> ConcurrentSubsetTable::intern(const StateBitSet& subset)
+{
+	// High bits pick the shard, the shard's own buckets use the low ones
+	const std::uint64_t mixed = static_cast<std::uint64_t>(subset.hash()) * 0x9E3779B97F4A7C15ull;
+	Shard& shard = *_shards[(mixed >> 32) % _shards.size()];
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	const auto local = shard.table.intern(subset);
+	if(!local.second)
+		return {shard.ids[local.first], false};
+	const IdType id = _size++;
+	shard.ids.push_back(id);
+	return {id, true};
+}
+
+} /* namespace Automata */
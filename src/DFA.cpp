@@ -1,5 +1,7 @@
 #include "DFA.h"
 
+#include <unordered_map>
+
 namespace Automata {
 
 DFA::DFA(const DFA& dfa)
@@ -22,12 +24,35 @@ StateSetType DFA::getFinalStates() const
 	return _nfa.getFinalStates();
 }
 
+size_t DFA::getNumberOfStates() const
+{
+	return _nfa.getNumberOfStates();
+}
+
 StateType DFA::move(const StateType& from, const SymbolType& symbol) const
 {
-	auto targets = _nfa.move(from, symbol);
+	const auto& targets = _nfa.move(from, symbol);
 	if(targets.empty())
 		throw std::invalid_argument("No transition from " + std::to_string(from) + " with symbol " + symbol);
-	return *_nfa.move(from, symbol).begin();
+	return *targets.begin();
+}
+
+StateType DFA::move(const StateType& from, const SymbolIdType& symbol) const
+{
+	const auto& targets = _nfa.move(from, symbol);
+	if(targets.empty())
+		throw std::invalid_argument("No transition from " + std::to_string(from) + " with symbol " + SymbolTable::getSymbol(symbol));
+	return *targets.begin();
+}
+
+const StateSetType& DFA::getTargets(const StateType& from, const SymbolIdType& symbol) const
+{
+	return _nfa.move(from, symbol);
+}
+
+const std::vector<SymbolIdType>& DFA::getSymbolIds() const
+{
+	return _nfa.getSymbolIds();
 }
 
 TransitionTable::TransitionIteratorTag DFA::getTransitions(const StateType& state) const
@@ -35,8 +60,87 @@ TransitionTable::TransitionIteratorTag DFA::getTransitions(const StateType& stat
 	return _nfa.getTransitions(state);
 }
 
-DFARunner::DFARunner(const DFA& dfa)
-:_runner(dfa._nfa)
+DenseDFA::DenseDFA(const DFA& dfa, const bool& unanchored)
+{
+	const size_t numberOfStates = dfa.getNumberOfStates();
+
+	_deadState = static_cast<IndexType>(numberOfStates);
+	_initialState = dfa.getInitialState();
+	_accepting.assign((numberOfStates + 1 + 63) / 64, 0);
+
+	// Only single byte symbols can be reached from a byte string
+	std::vector<std::vector<std::pair<unsigned char, IndexType>>> edges(numberOfStates);
+	for(const auto& state: dfa)
+		for(const auto& transition: dfa.getTransitions(state))
+		{
+			const SymbolType& symbol = transition.first;
+			if(symbol == Epsilon || symbol.size() != 1 || transition.second.empty())
+				continue;
+			edges[state].emplace_back(static_cast<unsigned char>(symbol[0]), *transition.second.begin());
+		}
+
+	// Bytes share a class while they go to the same target from every state seen so far.
+	// Each state splits classes by the targets of its explicit edges, bytes without an edge
+	// go to the missing target and keep their class. Ids are renumbered by first byte, so
+	// the result is the same as comparing whole columns.
+	const IndexType missing = unanchored ? _initialState : _deadState;
+	std::array<size_t, AlphabetSize> classOf{};
+	size_t numberOfClasses = 1;
+	std::unordered_map<std::uint64_t, size_t> splitClass;
+	// Split ids start after the current ones, so they stay under twice the alphabet size
+	std::array<size_t, 2 * AlphabetSize> renumbered;
+	for(const auto& stateEdges: edges)
+	{
+		splitClass.clear();
+		for(const auto& edge: stateEdges)
+			if(edge.second != missing)
+			{
+				const std::uint64_t key = (static_cast<std::uint64_t>(classOf[edge.first]) << 32) | edge.second;
+				classOf[edge.first] = splitClass.emplace(key, numberOfClasses + splitClass.size()).first->second;
+			}
+		if(splitClass.empty())
+			continue;
+		renumbered.fill(renumbered.size());
+		numberOfClasses = 0;
+		for(auto& symbolClass: classOf)
+		{
+			if(renumbered[symbolClass] == renumbered.size())
+				renumbered[symbolClass] = numberOfClasses++;
+			symbolClass = renumbered[symbolClass];
+		}
+	}
+	for(size_t byte = 0; byte < AlphabetSize; byte++)
+		_byteClasses[byte] = static_cast<ClassType>(classOf[byte]);
+	_numberOfClasses = numberOfClasses;
+
+	_table.assign((numberOfStates + 1) * _numberOfClasses, missing);
+	std::fill(std::begin(_table) + _deadState * _numberOfClasses, std::end(_table), _deadState);
+	for(IndexType state = 0; state < numberOfStates; state++)
+		for(const auto& edge: edges[state])
+			_table[state * _numberOfClasses + _byteClasses[edge.first]] = edge.second;
+
+	for(const auto& finalState: dfa.getFinalStates())
+		_accepting[finalState >> 6] |= std::uint64_t(1) << (finalState & 63);
+}
+
+DenseDFA::IndexType DenseDFA::run(const char* input, size_t length, IndexType state) const
+{
+	const IndexType* const table = _table.data();
+	const ClassType* const byteClasses = _byteClasses.data();
+	const size_t numberOfClasses = _numberOfClasses;
+	const auto* bytes = reinterpret_cast<const unsigned char*>(input);
+	for(size_t i = 0; i < length; i++)
+		state = table[static_cast<size_t>(state) * numberOfClasses + byteClasses[bytes[i]]];
+	return state;
+}
+
+bool DenseDFA::matches(const char* input, size_t length) const
+{
+	return isAccepting(run(input, length, _initialState));
+}
+
+DFARunner::DFARunner(const DFA& dfa, const Prefilter& prefilter)
+:_dense(dfa), _prefilter(prefilter), _filtered(!prefilter.empty())
 {
 }
 
@@ -56,9 +160,9 @@ TransitionTable::StateIterator end(const DFA& dfa)
 	return end(dfa._nfa);
 }
 
-bool DFARunner::run(const std::string& input)
+bool DFARunner::run(const std::string& input) const
 {
-	return _runner.run(input);
+	return (!_filtered || _prefilter.mayMatch(input.data(), input.size())) && _dense.matches(input.data(), input.size());
 }
 
 } /* namespace Automata */
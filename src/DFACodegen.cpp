@@ -0,0 +1,103 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CodeGenerator.h"
+#include "RegexCache.h"
+#include "RegexParser.h"
+
+// Compiles regexes to minimal DFAs at build time and writes <output>.h and <output>.cpp
+// with one matcher function per rule. A rules file has one "name regex" rule per line,
+// blank lines and lines starting with // are skipped.
+
+void printUsage()
+{
+	std::cerr << "Usage: DFACodegen [--switch|--table] -o <output> <name> <regex>" << std::endl;
+	std::cerr << "       DFACodegen [--switch|--table] -o <output> --rules <file>" << std::endl;
+}
+
+std::vector<std::pair<std::string, std::string>> readRules(const std::string& path)
+{
+	std::ifstream file(path);
+	if(!file)
+		throw std::invalid_argument("Cannot open " + path);
+
+	std::vector<std::pair<std::string, std::string>> rules;
+	std::string line;
+	while(std::getline(file, line))
+	{
+		std::istringstream iss(line);
+		std::string name, regex;
+		if(!(iss >> name) || name.compare(0, 2, "//") == 0)
+			continue;
+		if(!(iss >> regex))
+			throw std::invalid_argument("Rule " + name + " has no regex");
+		rules.emplace_back(name, regex);
+	}
+	return rules;
+}
+
+Automata::DenseDFA compile(const std::string& regex)
+{
+	return Automata::DenseDFA(Automata::RegexCache::compile(Automata::RegexParser::parse(regex)));
+}
+
+int main(int argc, char* argv[])
+{
+	Automata::CodeGenerator::Style style = Automata::CodeGenerator::Style::Switch;
+	std::string output;
+	std::vector<std::pair<std::string, std::string>> rules;
+
+	try
+	{
+		std::vector<std::string> positional;
+		for(int i = 1; i < argc; i++)
+		{
+			const std::string argument = argv[i];
+			if(argument == "--switch")
+				style = Automata::CodeGenerator::Style::Switch;
+			else if(argument == "--table")
+				style = Automata::CodeGenerator::Style::Table;
+			else if(argument == "-o" && i + 1 < argc)
+				output = argv[++i];
+			else if(argument == "--rules" && i + 1 < argc)
+				for(const auto& rule: readRules(argv[++i]))
+					rules.push_back(rule);
+			else
+				positional.push_back(argument);
+		}
+		if(positional.size() == 2)
+			rules.emplace_back(positional[0], positional[1]);
+		if(output.empty() || rules.empty() || (positional.size() != 0 && positional.size() != 2))
+		{
+			printUsage();
+			return EXIT_FAILURE;
+		}
+
+		std::vector<Automata::CodeGenerator::Matcher> matchers;
+		for(const auto& rule: rules)
+			matchers.push_back({rule.first, rule.second, compile(rule.second)});
+
+		std::ofstream header(output + ".h");
+		std::ofstream source(output + ".cpp");
+		if(!header || !source)
+			throw std::invalid_argument("Cannot write " + output);
+		Automata::CodeGenerator::emitHeader(matchers, header);
+		Automata::CodeGenerator::emitSource(matchers, style, source);
+	}
+	catch(const Automata::RegexParseError& e)
+	{
+		std::cerr << "Invalid RE: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch(const std::invalid_argument& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include "DFASearcher.h"
+
+#include <algorithm>
+
+#include "Powerset.h"
+#include "Hopcroft.h"
+#include "Thompson.h"
+
+namespace Automata {
+
+DFASearcher::DFASearcher(const NFA& nfa, const Prefilter& prefilter)
+:DFASearcher(Hopcroft::apply(Powerset::apply(nfa)), Hopcroft::apply(Powerset::applyUnanchored(nfa)),
+		Hopcroft::apply(Powerset::apply(Reverse::apply(nfa))), prefilter)
+{
+}
+
+DFASearcher::DFASearcher(const DFA& anchored, const DFA& unanchored, const DFA& reverse, const Prefilter& prefilter)
+:_forward(anchored), _unanchored(unanchored, true), _reverse(reverse), _prefilter(prefilter)
+{
+}
+
+bool DFASearcher::findFirst(const std::string& input, Match& match, const size_t& from) const
+{
+	if(from > input.size() || !mayMatch(input, from))
+		return false;
+	Doomed doomed;
+	return find(input, from, match, doomed);
+}
+
+std::vector<Match> DFASearcher::findAll(const std::string& input) const
+{
+	std::vector<Match> matches;
+	forEach(input, [&matches](const Match& match){ matches.push_back(match); });
+	return matches;
+}
+
+size_t DFASearcher::count(const std::string& input) const
+{
+	size_t numberOfMatches = 0;
+	forEach(input, [&numberOfMatches](const Match&){ numberOfMatches++; });
+	return numberOfMatches;
+}
+
+// Every match contains the factor, so without it past from there is nothing to find
+bool DFASearcher::mayMatch(const std::string& input, const size_t& from) const
+{
+	const std::string& factor = _prefilter.getFactor();
+	const char* const end = input.data() + input.size();
+	return factor.empty() || Prefilter::find(input.data() + from, end, factor) != end;
+}
+
+bool DFASearcher::find(const std::string& input, const size_t& from, Match& match, Doomed& doomed) const
+{
+	if(from > input.size())
+		return false;
+	const size_t end = earliestEnd(input, from);
+	if(end == Unknown)
+		return false;
+
+	// A match starting before last ends after end, the first start with any match wins
+	const size_t last = leftmostStart(input, from, end);
+	for(size_t begin = nextCandidate(input, from, last); begin < last; begin = nextCandidate(input, begin + 1, last))
+	{
+		const size_t longest = longestEnd(input, begin, doomed);
+		if(longest != Unknown)
+		{
+			match = Match{begin, longest};
+			return true;
+		}
+	}
+	match = Match{last, longestEnd(input, last, doomed)};
+	return true;
+}
+
+// First position from from on where a match ends
+size_t DFASearcher::earliestEnd(const std::string& input, const size_t& from) const
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(input.data());
+	DenseDFA::IndexType state = _unanchored.getInitialState();
+	if(_unanchored.isAccepting(state))
+		return from;
+	for(size_t i = from; i < input.size(); i++)
+	{
+		state = _unanchored.next(state, bytes[i]);
+		if(_unanchored.isAccepting(state))
+			return i + 1;
+	}
+	return Unknown;
+}
+
+// Leftmost start, not before from, of a match ending at end, which must exist
+size_t DFASearcher::leftmostStart(const std::string& input, const size_t& from, const size_t& end) const
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(input.data());
+	DenseDFA::IndexType state = _reverse.getInitialState();
+	size_t start = end;
+	for(size_t i = end; i > from && state != _reverse.getDeadState(); i--)
+	{
+		state = _reverse.next(state, bytes[i - 1]);
+		if(_reverse.isAccepting(state))
+			start = i - 1;
+	}
+	return start;
+}
+
+// Next position from from on that starts with the prefix, last if there is none before it
+size_t DFASearcher::nextCandidate(const std::string& input, const size_t& from, const size_t& last) const
+{
+	if(from >= last)
+		return last;
+	const char* const candidate = Prefilter::find(input.data() + from, input.data() + input.size(), _prefilter.getPrefix());
+	return std::min(static_cast<size_t>(candidate - input.data()), last);
+}
+
+// End of the longest match starting at begin, Unknown if there is none
+size_t DFASearcher::longestEnd(const std::string& input, const size_t& begin, Doomed& doomed) const
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(input.data());
+	const std::uint64_t numberOfStates = _forward.getNumberOfStates();
+	DenseDFA::IndexType state = _forward.getInitialState();
+	size_t end = _forward.isAccepting(state) ? begin : Unknown;
+	doomed.path.clear();
+	for(size_t i = begin; i < input.size(); i++)
+	{
+		state = _forward.next(state, bytes[i]);
+		if(state == _forward.getDeadState())
+			break;
+		const std::uint64_t pair = (i + 1) * numberOfStates + state;
+		if(i + 1 <= doomed.reached && doomed.pairs.count(pair) != 0)
+			break;
+		if(_forward.isAccepting(state))
+			end = i + 1;
+		doomed.path.push_back(pair);
+	}
+
+	// path[k] is at begin + k + 1, past the end nothing accepted. Later searches start at
+	// or after the end, so the pairs before it are never looked up.
+	const size_t firstDoomed = end == Unknown ? 0 : end - begin;
+	doomed.pairs.insert(std::begin(doomed.path) + std::min(firstDoomed, doomed.path.size()), std::end(doomed.path));
+	doomed.reached = std::max(doomed.reached, begin + doomed.path.size());
+	return end;
+}
+
+} /* namespace Automata */
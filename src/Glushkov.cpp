@@ -0,0 +1,132 @@
+#include "Glushkov.h"
+#include "Thompson.h"
+
+#include <algorithm>
+#include <stack>
+
+namespace Automata {
+
+Automata::NFA Glushkov::apply(const std::string& postfix)
+{
+	std::stack<Fragment> output;
+	std::vector<SymbolIdType> positionSymbols({EpsilonId}); // Position 0 is the initial state
+	std::vector<PositionsType> follow(1);
+
+	for(const auto& c: postfix)
+	{
+		if(Thompson::isConcatenationOperator(c))
+		{
+			const Fragment b = output.top(); output.pop();
+			const Fragment a = output.top(); output.pop();
+			output.push(concatenation(a, b, follow));
+		}
+		else if(Thompson::isAlternativeOperator(c))
+		{
+			const Fragment b = output.top(); output.pop();
+			const Fragment a = output.top(); output.pop();
+			output.push(alternative(a, b));
+		}
+		else if(Thompson::isKleeneOperator(c))
+		{
+			const Fragment a = output.top(); output.pop();
+			output.push(kleene(a, follow));
+		}
+		else if(c == EpsilonCharacter)
+		{
+			output.push({true, {}, {}});
+		}
+		else
+		{
+			const StateType position = static_cast<StateType>(positionSymbols.size());
+			positionSymbols.push_back(static_cast<unsigned char>(c));
+			follow.emplace_back();
+			output.push({false, {position}, {position}});
+		}
+	}
+
+	return build(output.top(), positionSymbols, follow);
+}
+
+Automata::NFA Glushkov::apply(const RegexAST& ast)
+{
+	std::vector<SymbolIdType> positionSymbols({EpsilonId});
+	std::vector<PositionsType> follow(1);
+
+	// Every use of a shared subtree gets positions of its own
+	const Fragment expression = ast.evaluate<Fragment>([&positionSymbols, &follow](const RegexAST::Node& node,
+			const Fragment* left, const Fragment* right)
+	{
+		switch(node.kind)
+		{
+		case RegexAST::Kind::Symbol:
+		{
+			const StateType position = static_cast<StateType>(positionSymbols.size());
+			positionSymbols.push_back(node.symbol);
+			follow.emplace_back();
+			return Fragment{false, {position}, {position}};
+		}
+		case RegexAST::Kind::Concatenation: return concatenation(*left, *right, follow);
+		case RegexAST::Kind::Alternative: return alternative(*left, *right);
+		case RegexAST::Kind::Kleene: return kleene(*left, follow);
+		default: return Fragment{true, {}, {}};
+		}
+	});
+
+	return build(expression, positionSymbols, follow);
+}
+
+Automata::NFA Glushkov::build(const Fragment& expression, const std::vector<SymbolIdType>& positionSymbols,
+		std::vector<PositionsType>& follow)
+{
+	TransitionTable transitionTable;
+	for(size_t position = 0; position < positionSymbols.size(); position++)
+		transitionTable.addState();
+	for(size_t position = 1; position < positionSymbols.size(); position++)
+		transitionTable.addSymbol(positionSymbols[position]);
+
+	// Entering a position always reads its symbol
+	addFollow(follow, {0}, expression.first);
+	for(StateType position = 0; position < follow.size(); position++)
+		for(const auto& next: follow[position])
+			transitionTable.addTransition(position, positionSymbols[next], next);
+
+	StateSetType finalStates(std::begin(expression.last), std::end(expression.last));
+	if(expression.nullable)
+		finalStates.insert(0);
+
+	return NFA(transitionTable, 0, finalStates);
+}
+
+Glushkov::Fragment Glushkov::concatenation(const Fragment& a, const Fragment& b, std::vector<PositionsType>& follow)
+{
+	addFollow(follow, a.last, b.first);
+	return {a.nullable && b.nullable,
+		a.nullable ? merge(a.first, b.first) : a.first,
+		b.nullable ? merge(a.last, b.last) : b.last};
+}
+
+Glushkov::Fragment Glushkov::alternative(const Fragment& a, const Fragment& b)
+{
+	return {a.nullable || b.nullable, merge(a.first, b.first), merge(a.last, b.last)};
+}
+
+Glushkov::Fragment Glushkov::kleene(const Fragment& a, std::vector<PositionsType>& follow)
+{
+	addFollow(follow, a.last, a.first);
+	return {true, a.first, a.last};
+}
+
+Glushkov::PositionsType Glushkov::merge(const PositionsType& lhs, const PositionsType& rhs)
+{
+	PositionsType positions;
+	std::set_union(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), std::back_inserter(positions));
+	return positions;
+}
+
+void Glushkov::addFollow(std::vector<PositionsType>& follow, const PositionsType& sources, const PositionsType& targets)
+{
+	for(const auto& source: sources)
+		follow[source] = merge(follow[source], targets);
+}
+
+} /* namespace Automata */
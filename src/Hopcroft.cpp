@@ -1,125 +1,425 @@
 #include "Hopcroft.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+
 namespace Automata {
 
 DFA Hopcroft::apply(const DFA& dfa)
 {
-	const auto alphabet = getAlphabet(dfa);
-	PartitionType partition = initialPartition(dfa);
+	std::vector<PatternSetType> minimalPatterns;
+	return apply(dfa, finalStatePatterns(dfa), minimalPatterns);
+}
+
+DFA Hopcroft::apply(const DFA& dfa, const std::vector<PatternSetType>& patterns, std::vector<PatternSetType>& minimalPatterns)
+{
+	if(patterns.size() != dfa.getNumberOfStates())
+		throw std::invalid_argument("Expected one pattern set per state");
+	const TotalDFA total = makeTotal(dfa, patterns);
+	return buildMinimal(total, refine(total), minimalPatterns);
+}
+
+DFA Hopcroft::applyParallel(const DFA& dfa, ThreadPool& pool)
+{
+	const TotalDFA total = makeTotal(dfa, finalStatePatterns(dfa));
+	std::vector<PatternSetType> minimalPatterns;
+	return buildMinimal(total, refineParallel(total, pool), minimalPatterns);
+}
+
+std::vector<PatternSetType> Hopcroft::finalStatePatterns(const DFA& dfa)
+{
+	std::vector<PatternSetType> patterns(dfa.getNumberOfStates());
+	for(const auto& finalState: dfa.getFinalStates())
+		patterns[finalState] = {0};
+	return patterns;
+}
 
-	PartitionType newPartition = improvePartition(dfa, partition, alphabet);
-	while(newPartition != partition)
+Hopcroft::TotalDFA Hopcroft::makeTotal(const DFA& dfa, const std::vector<PatternSetType>& patterns)
+{
+	TotalDFA total;
+
+	const SymbolClasses symbolClasses(dfa);
+	for(SymbolClasses::ClassType symbolClass = 0; symbolClass < symbolClasses.getNumberOfClasses(); symbolClass++)
+		total.classes.push_back(symbolClasses.getSymbolIds(symbolClass));
+
+	const size_t numberOfStates = dfa.getNumberOfStates() + 1;
+	total.sinkState = static_cast<StateType>(numberOfStates - 1);
+	total.initialState = dfa.getInitialState();
+	total.transitions.assign(numberOfStates * total.classes.size(), total.sinkState);
+
+	// Symbols of a class move alike, so the representative gives the whole row
+	for(const auto& state: dfa)
+		for(size_t symbolClass = 0; symbolClass < total.classes.size(); symbolClass++)
+		{
+			const StateSetType& targets = dfa.getTargets(state, total.classes[symbolClass].front());
+			if(!targets.empty())
+				total.transitions[state * total.classes.size() + symbolClass] = *targets.begin();
+		}
+
+	std::map<PatternSetType, IdType> groupOf({{PatternSetType(), 0}});
+	total.groupPatterns.emplace_back();
+	total.group.assign(numberOfStates, 0);
+	for(StateType state = 0; state < patterns.size(); state++)
 	{
-		partition = newPartition;
-		newPartition = improvePartition(dfa, partition, alphabet);
+		const auto iter = groupOf.emplace(patterns[state], static_cast<IdType>(groupOf.size())).first;
+		if(iter->second == total.groupPatterns.size())
+			total.groupPatterns.push_back(patterns[state]);
+		total.group[state] = iter->second;
 	}
 
-	DFABuilder<IdType> builder;
-	// Add transitions
-	for(const auto& group: partition)
+	// Unreachable states never take part in the minimal DFA
+	total.reachable.assign(numberOfStates, false);
+	std::vector<StateType> unprocessedStates({total.initialState});
+	total.reachable[total.initialState] = true;
+	while(!unprocessedStates.empty())
 	{
-		const auto& representativeState = *group.states.begin();
-		const auto& sourceLabel = group.id;
-		for(const auto& symbol: alphabet)
+		const StateType state = unprocessedStates.back();
+		unprocessedStates.pop_back();
+		for(size_t symbolClass = 0; symbolClass < total.classes.size(); symbolClass++)
 		{
-			const auto& targetState = dfa.move(representativeState, symbol);
-			const auto& targetLabel = findGroupId(partition, targetState);
-
-			builder.addTransition(sourceLabel, symbol, targetLabel);
+			const StateType target = total.move(state, symbolClass);
+			if(!total.reachable[target])
+			{
+				total.reachable[target] = true;
+				unprocessedStates.push_back(target);
+			}
 		}
 	}
-	// Find group with source state and set it to start state into the min DFA
-	for(const auto& group: partition)
-		if(group.states.find(dfa.getInitialState()) != std::end(group.states))
-		{
-			builder.setInitialStateLabel(group.id);
-			break;
-		}
-	// Find all groups with at least one final state and add them into the min DFA
-	const auto finalStates = dfa.getFinalStates();
-	for(const auto& group: partition)
-		for(const auto& finalState: finalStates)
-			if(group.states.find(finalState) != std::end(group.states))
-				builder.addFinalStateLabel(group.id);
-
-	return builder.build();
+
+	return total;
 }
 
-Hopcroft::PartitionType Hopcroft::initialPartition(const DFA& dfa)
+std::vector<Hopcroft::IdType> Hopcroft::refine(const TotalDFA& dfa)
 {
-	StateSetType acceptedStates = dfa.getFinalStates();
-	StateSetType nonAcceptedStates;
-	for(const auto& state: dfa)
-		if(acceptedStates.find(state) == std::end(acceptedStates))
-			nonAcceptedStates.insert(state);
+	const size_t numberOfClasses = dfa.classes.size();
+	const size_t numberOfStates = dfa.numberOfStates();
+
+	std::vector<StateType> states;
+	for(StateType state = 0; state < numberOfStates; state++)
+		if(dfa.reachable[state])
+			states.push_back(state);
+
+	// Inverse transitions, predecessors of (target, symbolClass) live in one offsets range
+	std::vector<size_t> inverseOffsets(numberOfStates * numberOfClasses + 1, 0);
+	for(const auto& state: states)
+		for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+			inverseOffsets[dfa.move(state, symbolClass) * numberOfClasses + symbolClass + 1]++;
+	for(size_t i = 1; i < inverseOffsets.size(); i++)
+		inverseOffsets[i] += inverseOffsets[i - 1];
+	std::vector<StateType> inverse(inverseOffsets.back());
+	std::vector<size_t> fill(std::begin(inverseOffsets), std::end(inverseOffsets) - 1);
+	for(const auto& state: states)
+		for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+			inverse[fill[dfa.move(state, symbolClass) * numberOfClasses + symbolClass]++] = state;
 
-	PartitionType partition;
-	partition.insert({acceptedStates, 0});
-	partition.insert({nonAcceptedStates, 1});
+	Partition partition(states, dfa.group, dfa.groupPatterns.size());
 
-	return partition;
+	std::vector<std::pair<IdType, size_t>> worklist;
+	std::vector<bool> inWorklist(numberOfStates * numberOfClasses, false);
+	const auto addSplitter = [&](const IdType& block, const size_t& symbolClass)
+	{
+		inWorklist[block * numberOfClasses + symbolClass] = true;
+		worklist.emplace_back(block, symbolClass);
+	};
+
+	// Every initial block but the largest one is a splitter
+	IdType largest = 0;
+	for(IdType block = 1; block < partition.numberOfBlocks(); block++)
+		if(partition.blockSize(block) > partition.blockSize(largest))
+			largest = block;
+	for(IdType block = 0; block < partition.numberOfBlocks(); block++)
+		if(block != largest)
+			for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+				addSplitter(block, symbolClass);
+
+	std::vector<StateType> splitter;
+	std::vector<IdType> touchedBlocks;
+	while(!worklist.empty())
+	{
+		const IdType block = worklist.back().first;
+		const size_t symbolClass = worklist.back().second;
+		worklist.pop_back();
+		inWorklist[block * numberOfClasses + symbolClass] = false;
+
+		// Marking reorders blocks in place, so the splitter is copied out first
+		splitter.assign(std::begin(partition.elements) + partition.blockStart[block],
+				std::begin(partition.elements) + partition.blockEnd[block]);
+		for(const auto& target: splitter)
+		{
+			const size_t index = target * numberOfClasses + symbolClass;
+			for(size_t i = inverseOffsets[index]; i < inverseOffsets[index + 1]; i++)
+				if(partition.mark(inverse[i]))
+					touchedBlocks.push_back(partition.blockOf[inverse[i]]);
+		}
+
+		for(const auto& touchedBlock: touchedBlocks)
+		{
+			const IdType newBlock = partition.split(touchedBlock);
+			if(newBlock == touchedBlock)
+				continue;
+			// Only the smaller half is needed unless the old block was still pending
+			const IdType smaller = partition.blockSize(newBlock) <= partition.blockSize(touchedBlock) ? newBlock : touchedBlock;
+			for(size_t other = 0; other < numberOfClasses; other++)
+				if(inWorklist[touchedBlock * numberOfClasses + other])
+					addSplitter(newBlock, other);
+				else
+					addSplitter(smaller, other);
+		}
+		touchedBlocks.clear();
+	}
+
+	std::vector<IdType> blockOf(numberOfStates, static_cast<IdType>(-1));
+	for(const auto& state: states)
+		blockOf[state] = partition.blockOf[state];
+	return blockOf;
 }
 
-Hopcroft::PartitionType Hopcroft::improvePartition(const DFA& dfa, const PartitionType& partition, const AlphabetType& alphabet)
+std::vector<Hopcroft::IdType> Hopcroft::refineParallel(const TotalDFA& dfa, ThreadPool& pool)
 {
-	IdType groupIdCounter = 0;
-	PartitionType newPartition;
+	const size_t numberOfClasses = dfa.classes.size();
+	const size_t numberOfStates = dfa.numberOfStates();
+	const IdType unreachable = static_cast<IdType>(-1);
 
-	for(const auto& group: partition)
+	std::vector<StateType> states;
+	for(StateType state = 0; state < numberOfStates; state++)
+		if(dfa.reachable[state])
+			states.push_back(state);
+
+	std::vector<IdType> blockOf(numberOfStates, unreachable);
+	size_t numberOfBlocks = 0;
 	{
-		bool copyOriginalGroupToNewPartition = true;
-		for(const auto& symbol: alphabet)
+		std::vector<IdType> renumbered(dfa.groupPatterns.size(), unreachable);
+		for(const auto& state: states)
 		{
-			std::map<IdType, StateSetType> newGroups;
+			if(renumbered[dfa.group[state]] == unreachable)
+				renumbered[dfa.group[state]] = static_cast<IdType>(numberOfBlocks++);
+			blockOf[state] = renumbered[dfa.group[state]];
+		}
+	}
 
-			for(const auto& state: group.states)
+	const size_t numberOfTasks = pool.size() * 4;
+	const auto forEachRange = [&](const size_t& size, const std::function<void(size_t, size_t)>& function)
+	{
+		pool.run(numberOfTasks, [&](size_t task)
+		{
+			function(size * task / numberOfTasks, size * (task + 1) / numberOfTasks);
+		});
+	};
+
+	// Each round splits every block by the signature (block, block of every successor).
+	// Blocks split independently: states are grouped by block, then each group is sorted by
+	// signature hash and signature on the pool, and equal signatures share a new block.
+	std::vector<IdType> signatures(numberOfStates * (numberOfClasses + 1));
+	std::vector<size_t> hashes(numberOfStates);
+	std::vector<StateType> members(states.size());
+	std::vector<size_t> blockStart;
+	std::vector<size_t> newBlocks;
+	std::vector<IdType> localBlock(numberOfStates);
+	while(true)
+	{
+		forEachRange(states.size(), [&](size_t begin, size_t end)
+		{
+			for(size_t i = begin; i < end; i++)
 			{
-				const auto nextState = dfa.move(state, symbol);
-				const auto groupId = findGroupId(partition, nextState);
-				newGroups[groupId].insert(state);
+				const StateType state = states[i];
+				IdType* signature = signatures.data() + state * (numberOfClasses + 1);
+				signature[0] = blockOf[state];
+				size_t hash = blockOf[state];
+				for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+				{
+					signature[symbolClass + 1] = blockOf[dfa.move(state, symbolClass)];
+					hash = hash * 1000003u ^ signature[symbolClass + 1];
+				}
+				hashes[state] = hash;
 			}
+		});
+
+		// Counting sort by current block
+		blockStart.assign(numberOfBlocks + 1, 0);
+		for(const auto& state: states)
+			blockStart[blockOf[state] + 1]++;
+		for(size_t block = 1; block <= numberOfBlocks; block++)
+			blockStart[block] += blockStart[block - 1];
+		{
+			std::vector<size_t> fill(std::begin(blockStart), std::end(blockStart) - 1);
+			for(const auto& state: states)
+				members[fill[blockOf[state]]++] = state;
+		}
 
-			if(newGroups.size() > 1)
+		newBlocks.assign(numberOfBlocks + 1, 0);
+		forEachRange(numberOfBlocks, [&](size_t begin, size_t end)
+		{
+			for(size_t block = begin; block < end; block++)
 			{
-				for(const auto& p: newGroups)
+				const auto first = std::begin(members) + blockStart[block];
+				const auto last = std::begin(members) + blockStart[block + 1];
+				const auto signatureOf = [&](const StateType& state){ return signatures.data() + state * (numberOfClasses + 1); };
+				const auto less = [&](const StateType& lhs, const StateType& rhs)
 				{
-					const auto& states = p.second;
-					const auto& groupId = groupIdCounter++;
-					newPartition.insert({states, groupId});
+					if(hashes[lhs] != hashes[rhs])
+						return hashes[lhs] < hashes[rhs];
+					return std::lexicographical_compare(signatureOf(lhs), signatureOf(lhs) + numberOfClasses + 1,
+							signatureOf(rhs), signatureOf(rhs) + numberOfClasses + 1);
+				};
+				std::sort(first, last, less);
+
+				IdType local = 0;
+				for(auto iter = first; iter != last; ++iter)
+				{
+					if(iter != first && less(*(iter - 1), *iter))
+						local++;
+					localBlock[*iter] = local;
 				}
-				copyOriginalGroupToNewPartition = false;
-				break;
+				newBlocks[block + 1] = local + 1;
 			}
-		}
-		if(copyOriginalGroupToNewPartition)
-			newPartition.insert({group.states, groupIdCounter++});
+		});
+
+		for(size_t block = 1; block <= numberOfBlocks; block++)
+			newBlocks[block] += newBlocks[block - 1];
+		if(newBlocks[numberOfBlocks] == numberOfBlocks)
+			break;
+
+		for(const auto& state: states)
+			blockOf[state] = static_cast<IdType>(newBlocks[blockOf[state]] + localBlock[state]);
+		numberOfBlocks = newBlocks[numberOfBlocks];
 	}
 
-	return newPartition;
+	return blockOf;
 }
 
-AlphabetType Hopcroft::getAlphabet(const DFA& dfa)
+DFA Hopcroft::buildMinimal(const TotalDFA& dfa, const std::vector<IdType>& blockOf, std::vector<PatternSetType>& minimalPatterns)
 {
-	AlphabetType alphabet;
-	for(const auto& state: dfa)
+	const IdType unnumbered = static_cast<IdType>(-1);
+	const size_t numberOfClasses = dfa.classes.size();
+
+	std::vector<StateType> representative;
+	std::vector<bool> sinkOnly;
+	for(StateType state = 0; state < dfa.numberOfStates(); state++)
 	{
-		for(const auto& transition: dfa.getTransitions(state))
+		const IdType block = blockOf[state];
+		if(block == unnumbered)
+			continue;
+		if(block >= representative.size())
 		{
-			const auto symbol = transition.first;
-			if(symbol != Epsilon)
-				alphabet.insert(symbol);
+			representative.resize(block + 1, dfa.sinkState);
+			sinkOnly.resize(block + 1, true);
+		}
+		if(state != dfa.sinkState)
+		{
+			representative[block] = state;
+			sinkOnly[block] = false;
 		}
 	}
-	return alphabet;
+
+	// Number blocks breadth first from the initial one so the output does not depend
+	// on the order blocks were split in. The block holding only the sink is left out.
+	std::vector<IdType> numbering(representative.size(), unnumbered);
+	std::vector<IdType> order({blockOf[dfa.initialState]});
+	numbering[order.front()] = 0;
+	for(size_t i = 0; i < order.size(); i++)
+		for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+		{
+			const IdType target = blockOf[dfa.move(representative[order[i]], symbolClass)];
+			if(numbering[target] == unnumbered && !sinkOnly[target])
+			{
+				numbering[target] = static_cast<IdType>(order.size());
+				order.push_back(target);
+			}
+		}
+
+	TransitionTable transitionTable;
+	for(size_t i = 0; i < order.size(); i++)
+		transitionTable.addState();
+	for(const auto& symbols: dfa.classes)
+		for(const auto& symbol: symbols)
+			transitionTable.addSymbol(symbol);
+
+	StateSetType finalStates;
+	minimalPatterns.assign(order.size(), PatternSetType());
+	for(size_t i = 0; i < order.size(); i++)
+	{
+		const StateType state = representative[order[i]];
+		for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+		{
+			const IdType target = blockOf[dfa.move(state, symbolClass)];
+			if(!sinkOnly[target])
+				for(const auto& classSymbol: dfa.classes[symbolClass])
+					transitionTable.addTransition(static_cast<StateType>(i), classSymbol, numbering[target]);
+		}
+		if(dfa.isAccepting(state))
+			finalStates.insert(static_cast<StateType>(i));
+		minimalPatterns[i] = dfa.groupPatterns[dfa.group[state]];
+	}
+
+	return DFA(NFA(transitionTable, 0, finalStates));
+}
+
+// Partition
+Hopcroft::Partition::Partition(const std::vector<StateType>& states, const std::vector<IdType>& group, const size_t& numberOfGroups)
+:elements(states.size()), location(group.size(), 0), blockOf(group.size(), 0)
+{
+	// Counting sort by group, empty groups get no block
+	std::vector<size_t> groupSize(numberOfGroups, 0);
+	for(const auto& state: states)
+		groupSize[group[state]]++;
+
+	std::vector<size_t> next(numberOfGroups, 0);
+	std::vector<IdType> groupBlock(numberOfGroups, 0);
+	size_t start = 0;
+	for(IdType initialGroup = 0; initialGroup < numberOfGroups; initialGroup++)
+	{
+		if(groupSize[initialGroup] == 0)
+			continue;
+		next[initialGroup] = start;
+		groupBlock[initialGroup] = static_cast<IdType>(blockStart.size());
+		blockStart.push_back(start);
+		start += groupSize[initialGroup];
+		blockEnd.push_back(start);
+		marked.push_back(0);
+	}
+
+	for(const auto& state: states)
+	{
+		const size_t position = next[group[state]]++;
+		location[state] = position;
+		blockOf[state] = groupBlock[group[state]];
+		elements[position] = state;
+	}
 }
 
-Hopcroft::IdType Hopcroft::findGroupId(const PartitionType& partition, const StateType& state)
+bool Hopcroft::Partition::mark(const StateType& state)
 {
-	for(const auto& group: partition)
-		for(const auto& groupState: group.states)
-			if(state == groupState)
-				return group.id;
-	throw std::invalid_argument("State is not contained in this partition.");
+	const IdType block = blockOf[state];
+	const size_t position = location[state];
+	const size_t firstUnmarked = blockStart[block] + marked[block];
+	if(position < firstUnmarked)
+		return false;
+
+	const StateType other = elements[firstUnmarked];
+	std::swap(elements[position], elements[firstUnmarked]);
+	location[other] = position;
+	location[state] = firstUnmarked;
+	return marked[block]++ == 0;
+}
+
+Hopcroft::IdType Hopcroft::Partition::split(const IdType& block)
+{
+	const size_t markedCount = marked[block];
+	marked[block] = 0;
+	if(markedCount == blockSize(block))
+		return block;
+
+	// The marked prefix becomes a new block, the old id keeps the rest
+	const IdType newBlock = static_cast<IdType>(numberOfBlocks());
+	blockStart.push_back(blockStart[block]);
+	blockEnd.push_back(blockStart[block] + markedCount);
+	marked.push_back(0);
+	blockStart[block] += markedCount;
+	for(size_t i = blockStart[newBlock]; i < blockEnd[newBlock]; i++)
+		blockOf[elements[i]] = newBlock;
+	return newBlock;
 }
 
 } /* namespace Automata */
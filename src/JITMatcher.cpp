@@ -0,0 +1,230 @@
+#include "JITMatcher.h"
+
+#include <cstring>
+#include <initializer_list>
+#include <map>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define AUTOMATA_JIT 1
+#endif
+
+namespace Automata {
+
+namespace {
+
+// Byte buffer with labels and 32 bit fixups resolved once all labels are placed
+class Assembler
+{
+private:
+	struct Fixup
+	{
+		size_t position;
+		size_t label;
+		size_t base;
+		bool relativeToLabel;
+	};
+
+	std::vector<std::uint8_t> _bytes;
+	std::vector<size_t> _labels;
+	std::vector<Fixup> _fixups;
+
+public:
+	Assembler(const size_t& numberOfLabels):_bytes(), _labels(numberOfLabels, 0), _fixups() {}
+
+	void bind(const size_t& label) { _labels[label] = _bytes.size(); }
+	void align(const size_t& alignment)
+	{
+		while(_bytes.size() % alignment != 0)
+			emit({0xCC});
+	}
+	void emit(std::initializer_list<std::uint8_t> bytes) { _bytes.insert(std::end(_bytes), bytes); }
+	void emit32(const std::uint32_t& value)
+	{
+		for(size_t i = 0; i < 4; i++)
+			_bytes.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+	}
+	// rel32 operand ending the instruction, relative to the next instruction
+	void emitRelative(const size_t& label)
+	{
+		_fixups.push_back({_bytes.size(), label, _bytes.size() + 4, false});
+		emit32(0);
+	}
+	// Offset of label from another label, for jump table entries
+	void emitOffset(const size_t& label, const size_t& base)
+	{
+		_fixups.push_back({_bytes.size(), label, base, true});
+		emit32(0);
+	}
+	std::vector<std::uint8_t> finish()
+	{
+		for(const auto& fixup: _fixups)
+		{
+			const size_t base = fixup.relativeToLabel ? _labels[fixup.base] : fixup.base;
+			const std::uint32_t value = static_cast<std::uint32_t>(static_cast<std::int64_t>(_labels[fixup.label]) - static_cast<std::int64_t>(base));
+			for(size_t i = 0; i < 4; i++)
+				_bytes[fixup.position + i] = static_cast<std::uint8_t>(value >> (8 * i));
+		}
+		return std::move(_bytes);
+	}
+};
+
+} /* namespace */
+
+JITMatcher::JITMatcher(const DenseDFA& dfa)
+:_dfa(dfa), _code(nullptr), _codeSize(0), _function(nullptr)
+{
+#ifdef AUTOMATA_JIT
+	const std::vector<std::uint8_t> code = assemble(dfa);
+	void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(memory == MAP_FAILED)
+		return;
+	std::memcpy(memory, code.data(), code.size());
+	if(mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0)
+	{
+		munmap(memory, code.size());
+		return;
+	}
+	_code = memory;
+	_codeSize = code.size();
+	_function = reinterpret_cast<Function>(memory);
+#endif
+}
+
+JITMatcher::~JITMatcher()
+{
+#ifdef AUTOMATA_JIT
+	if(_code != nullptr)
+		munmap(_code, _codeSize);
+#endif
+}
+
+bool JITMatcher::matches(const char* input, size_t length) const
+{
+	if(_function == nullptr)
+		return _dfa.matches(input, length);
+	const auto* begin = reinterpret_cast<const unsigned char*>(input);
+	return _function(begin, begin + length) != 0;
+}
+
+// int match(const unsigned char* p, const unsigned char* end), p in rdi and end in rsi.
+// Only rax, rcx and rdi are written, all caller saved, and nothing touches the stack.
+std::vector<std::uint8_t> JITMatcher::assemble(const DenseDFA& dfa)
+{
+	const size_t numberOfStates = dfa.getNumberOfStates();
+	const DenseDFA::IndexType dead = dfa.getDeadState();
+	const size_t acceptLabel = numberOfStates;
+	const size_t rejectLabel = numberOfStates + 1;
+	const size_t classMapLabel = numberOfStates + 2;
+	const auto tableLabel = [&numberOfStates](const size_t& state){ return numberOfStates + 3 + state; };
+	const auto stateLabel = [&dead, &rejectLabel](const size_t& state){ return state == dead ? rejectLabel : state; };
+
+	Assembler assembler(2 * numberOfStates + 3);
+	std::vector<bool> usesTable(numberOfStates, false);
+
+	assembler.emit({0xE9});                                  // jmp initial
+	assembler.emitRelative(stateLabel(dfa.getInitialState()));
+
+	for(DenseDFA::IndexType state = 0; state < numberOfStates; state++)
+	{
+		if(state == dead)
+			continue;
+		assembler.align(16);
+		assembler.bind(state);
+		assembler.emit({0x48, 0x39, 0xF7});                  // cmp rdi, rsi
+		assembler.emit({0x0F, 0x83});                        // jae accept/reject
+		assembler.emitRelative(dfa.isAccepting(state) ? acceptLabel : rejectLabel);
+		assembler.emit({0x0F, 0xB6, 0x07});                  // movzx eax, byte [rdi]
+		assembler.emit({0x48, 0x83, 0xC7, 0x01});            // add rdi, 1
+
+		// Maximal runs of bytes going to the same state, the most common target is the default
+		struct Range
+		{
+			unsigned low;
+			unsigned high;
+			DenseDFA::IndexType target;
+		};
+		std::vector<Range> ranges;
+		std::map<DenseDFA::IndexType, size_t> bytesTo;
+		for(unsigned byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+		{
+			const DenseDFA::IndexType target = dfa.next(state, static_cast<unsigned char>(byte));
+			bytesTo[target]++;
+			if(!ranges.empty() && ranges.back().target == target)
+				ranges.back().high = byte;
+			else
+				ranges.push_back({byte, byte, target});
+		}
+		DenseDFA::IndexType defaultTarget = bytesTo.begin()->first;
+		for(const auto& entry: bytesTo)
+			if(entry.second > bytesTo[defaultTarget])
+				defaultTarget = entry.first;
+		size_t numberOfRanges = 0;
+		for(const auto& range: ranges)
+			numberOfRanges += range.target != defaultTarget;
+
+		if(numberOfRanges <= MaxCompareRanges)
+		{
+			for(const auto& range: ranges)
+			{
+				if(range.target == defaultTarget)
+					continue;
+				if(range.low == range.high)
+				{
+					assembler.emit({0x3D});                  // cmp eax, byte
+					assembler.emit32(range.low);
+					assembler.emit({0x0F, 0x84});            // je target
+				}
+				else
+				{
+					assembler.emit({0x8D, 0x88});            // lea ecx, [rax - low]
+					assembler.emit32(-range.low);
+					assembler.emit({0x81, 0xF9});            // cmp ecx, high - low
+					assembler.emit32(range.high - range.low);
+					assembler.emit({0x0F, 0x86});            // jbe target
+				}
+				assembler.emitRelative(stateLabel(range.target));
+			}
+			assembler.emit({0xE9});                          // jmp default
+			assembler.emitRelative(stateLabel(defaultTarget));
+		}
+		else
+		{
+			usesTable[state] = true;
+			assembler.emit({0x48, 0x8D, 0x0D});              // lea rcx, [rip + classMap]
+			assembler.emitRelative(classMapLabel);
+			assembler.emit({0x0F, 0xB6, 0x04, 0x01});        // movzx eax, byte [rcx + rax]
+			assembler.emit({0x48, 0x8D, 0x0D});              // lea rcx, [rip + table]
+			assembler.emitRelative(tableLabel(state));
+			assembler.emit({0x48, 0x63, 0x04, 0x81});        // movsxd rax, dword [rcx + rax * 4]
+			assembler.emit({0x48, 0x01, 0xC8});              // add rax, rcx
+			assembler.emit({0xFF, 0xE0});                    // jmp rax
+		}
+	}
+
+	assembler.align(16);
+	assembler.bind(acceptLabel);
+	assembler.emit({0xB8, 0x01, 0x00, 0x00, 0x00});          // mov eax, 1
+	assembler.emit({0xC3});                                  // ret
+	assembler.bind(rejectLabel);
+	assembler.emit({0x31, 0xC0});                            // xor eax, eax
+	assembler.emit({0xC3});                                  // ret
+
+	// Byte class map and, per table dispatched state, one offset from the table per class
+	assembler.align(16);
+	assembler.bind(classMapLabel);
+	for(const auto& symbolClass: dfa.getByteClasses())
+		assembler.emit({symbolClass});
+	for(DenseDFA::IndexType state = 0; state < numberOfStates; state++)
+	{
+		if(!usesTable[state])
+			continue;
+		assembler.bind(tableLabel(state));
+		for(size_t symbolClass = 0; symbolClass < dfa.getNumberOfClasses(); symbolClass++)
+			assembler.emitOffset(stateLabel(dfa.getTable()[state * dfa.getNumberOfClasses() + symbolClass]), tableLabel(state));
+	}
+
+	return assembler.finish();
+}
+
+} /* namespace Automata */
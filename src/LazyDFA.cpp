@@ -0,0 +1,125 @@
+#include "LazyDFA.h"
+
+#include <map>
+
+namespace Automata {
+
+LazyDFARunner::LazyDFARunner(const NFA& nfa, size_t memoryBudget)
+:_numberOfStates(nfa.getNumberOfStates()), _memoryBudget(memoryBudget),
+ _finalStates(nfa.getNumberOfStates(), nfa.getFinalStates()), _cache(nfa.getNumberOfStates()), _numberOfFlushes(0),
+ _current(nfa.getNumberOfStates()), _next(nfa.getNumberOfStates())
+{
+	const EpsilonClosure closure(nfa);
+	for(const auto& state: nfa)
+		_closures.push_back(closure.getClosureBits(state));
+	_startSubset = _closures[nfa.getInitialState()];
+
+	// Bytes with the same edges everywhere share a class
+	std::array<std::vector<std::pair<StateType, StateType>>, AlphabetSize> edgesByByte;
+	for(const auto& state: nfa)
+		for(const auto& transition: nfa.getTransitions(state))
+		{
+			const SymbolType& symbol = transition.first;
+			// Only single byte symbols can be reached from a byte string
+			if(symbol == Epsilon || symbol.size() != 1)
+				continue;
+			for(const auto& target: transition.second)
+				edgesByByte[static_cast<unsigned char>(symbol[0])].emplace_back(state, target);
+		}
+
+	std::map<std::vector<std::pair<StateType, StateType>>, ClassType> classOfEdges;
+	for(size_t byte = 0; byte < AlphabetSize; byte++)
+		_byteClasses[byte] = classOfEdges.emplace(edgesByByte[byte], static_cast<ClassType>(classOfEdges.size())).first->second;
+	_numberOfClasses = classOfEdges.size();
+
+	std::vector<std::vector<std::pair<ClassType, StateType>>> edges(_numberOfStates);
+	for(const auto& p: classOfEdges)
+		for(const auto& edge: p.first)
+			edges[edge.first].emplace_back(p.second, edge.second);
+	_edgeOffsets.push_back(0);
+	for(const auto& stateEdges: edges)
+	{
+		for(const auto& edge: stateEdges)
+		{
+			_edgeClasses.push_back(edge.first);
+			_edgeTargets.push_back(edge.second);
+		}
+		_edgeOffsets.push_back(_edgeTargets.size());
+	}
+
+	flush();
+	_numberOfFlushes = 0;
+}
+
+bool LazyDFARunner::run(const std::string& input)
+{
+	StateType state = _startState;
+	for(const char& c: input)
+	{
+		const ClassType byteClass = _byteClasses[static_cast<unsigned char>(c)];
+		StateType next = _transitions[state * _numberOfClasses + byteClass];
+		if(next == Unknown)
+			next = computeTransition(state, byteClass);
+		state = next;
+		if(state == _deadState)
+			return false;
+	}
+	return _accepting[state];
+}
+
+size_t LazyDFARunner::getMemoryUsage() const
+{
+	// Live sizes: flushing keeps the capacity, so counting it would leave the runner over
+	// budget for good and make every uncached transition flush again
+	return _cache.getMemoryUsage() + _transitions.size() * sizeof(StateType) + _accepting.size() / 8;
+}
+
+StateType LazyDFARunner::computeTransition(const StateType& state, const ClassType& byteClass)
+{
+	_cache.getSubset(state, _current);
+	_next.clear();
+	_current.forEach([this, &byteClass](const StateType& nfaState)
+	{
+		for(size_t edge = _edgeOffsets[nfaState]; edge < _edgeOffsets[nfaState + 1]; edge++)
+			if(_edgeClasses[edge] == byteClass)
+				_next |= _closures[_edgeTargets[edge]];
+	});
+
+	// After a flush the old id of the source is gone, so the edge is simply not cached
+	if(getMemoryUsage() > _memoryBudget)
+	{
+		flush();
+		return addState(_next);
+	}
+
+	const StateType next = addState(_next);
+	_transitions[state * _numberOfClasses + byteClass] = next;
+	return next;
+}
+
+StateType LazyDFARunner::addState(const StateBitSet& subset)
+{
+	const auto result = _cache.intern(subset);
+	if(result.second)
+	{
+		_transitions.resize(_transitions.size() + _numberOfClasses, Unknown);
+		_accepting.push_back(subset.intersects(_finalStates));
+	}
+	return result.first;
+}
+
+void LazyDFARunner::flush()
+{
+	_cache.clear();
+	_transitions.clear();
+	_accepting.clear();
+	_numberOfFlushes++;
+
+	_startState = addState(_startSubset);
+	_deadState = addState(StateBitSet(_numberOfStates));
+	// The dead state never leaves itself
+	for(size_t byteClass = 0; byteClass < _numberOfClasses; byteClass++)
+		_transitions[_deadState * _numberOfClasses + byteClass] = _deadState;
+}
+
+} /* namespace Automata */
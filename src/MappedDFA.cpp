@@ -0,0 +1,122 @@
+#include "MappedDFA.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Automata {
+
+MappedDFA::MappedDFA(const std::string& path)
+:_file(new MappedFile(path))
+{
+	load(_file->data(), _file->size());
+}
+
+MappedDFA::MappedDFA(const char* data, size_t size)
+:_file()
+{
+	load(data, size);
+}
+
+void MappedDFA::load(const char* data, size_t size)
+{
+	if(reinterpret_cast<std::uintptr_t>(data) % 8 != 0)
+		throw std::invalid_argument("DFA image must be 8 byte aligned");
+	if(size < sizeof(Header))
+		throw std::invalid_argument("DFA image too small");
+
+	const Header& header = *reinterpret_cast<const Header*>(data);
+	if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+		throw std::invalid_argument("Not a DFA image");
+	if(header.byteOrder != ByteOrder)
+		throw std::invalid_argument("DFA image has a different byte order");
+	if(header.version != Version)
+		throw std::invalid_argument("Unsupported DFA image version " + std::to_string(header.version));
+
+	const std::uint64_t numberOfStates = header.numberOfStates;
+	const std::uint64_t numberOfClasses = header.numberOfClasses;
+	const std::uint64_t tableSize = numberOfStates * numberOfClasses * sizeof(IndexType);
+	const std::uint64_t acceptingSize = (numberOfStates + 63) / 64 * sizeof(std::uint64_t);
+	if(header.size != size || numberOfStates == 0 || numberOfClasses == 0 || numberOfClasses > DenseDFA::AlphabetSize
+			|| header.initialState >= numberOfStates || header.deadState >= numberOfStates
+			|| header.classesOffset != align(sizeof(Header))
+			|| header.tableOffset != align(header.classesOffset + DenseDFA::AlphabetSize)
+			|| header.acceptingOffset != align(header.tableOffset + tableSize)
+			|| header.acceptingOffset + acceptingSize != size)
+		throw std::invalid_argument("Corrupt DFA image header");
+
+	_byteClasses = reinterpret_cast<const ClassType*>(data + header.classesOffset);
+	_table = reinterpret_cast<const IndexType*>(data + header.tableOffset);
+	_accepting = reinterpret_cast<const std::uint64_t*>(data + header.acceptingOffset);
+	_numberOfStates = numberOfStates;
+	_numberOfClasses = numberOfClasses;
+	_initialState = header.initialState;
+	_deadState = header.deadState;
+
+	for(size_t byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+		if(_byteClasses[byte] >= _numberOfClasses)
+			throw std::invalid_argument("Corrupt DFA image byte classes");
+	for(size_t i = 0; i < _numberOfStates * _numberOfClasses; i++)
+		if(_table[i] >= _numberOfStates)
+			throw std::invalid_argument("Corrupt DFA image transition table");
+}
+
+MappedDFA::IndexType MappedDFA::run(const char* input, size_t length, IndexType state) const
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(input);
+	for(size_t i = 0; i < length; i++)
+		state = _table[static_cast<size_t>(state) * _numberOfClasses + _byteClasses[bytes[i]]];
+	return state;
+}
+
+bool MappedDFA::matches(const char* input, size_t length) const
+{
+	return isAccepting(run(input, length, _initialState));
+}
+
+void MappedDFA::write(const DenseDFA& dfa, std::ostream& os)
+{
+	const std::vector<IndexType>& table = dfa.getTable();
+	const size_t numberOfStates = dfa.getNumberOfStates();
+
+	Header header;
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.byteOrder = ByteOrder;
+	header.version = Version;
+	header.numberOfStates = static_cast<std::uint32_t>(numberOfStates);
+	header.numberOfClasses = static_cast<std::uint32_t>(dfa.getNumberOfClasses());
+	header.initialState = dfa.getInitialState();
+	header.deadState = dfa.getDeadState();
+	header.classesOffset = align(sizeof(Header));
+	header.tableOffset = align(header.classesOffset + DenseDFA::AlphabetSize);
+	header.acceptingOffset = align(header.tableOffset + table.size() * sizeof(IndexType));
+
+	std::vector<std::uint64_t> accepting((numberOfStates + 63) / 64, 0);
+	for(IndexType state = 0; state < numberOfStates; state++)
+		if(dfa.isAccepting(state))
+			accepting[state >> 6] |= std::uint64_t(1) << (state & 63);
+	header.size = header.acceptingOffset + accepting.size() * sizeof(std::uint64_t);
+
+	const char padding[8] = {};
+	const auto pad = [&os, &padding](const std::uint64_t& from, const std::uint64_t& to){ os.write(padding, to - from); };
+	os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	pad(sizeof(Header), header.classesOffset);
+	os.write(reinterpret_cast<const char*>(dfa.getByteClasses().data()), DenseDFA::AlphabetSize);
+	pad(header.classesOffset + DenseDFA::AlphabetSize, header.tableOffset);
+	os.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(IndexType));
+	pad(header.tableOffset + table.size() * sizeof(IndexType), header.acceptingOffset);
+	os.write(reinterpret_cast<const char*>(accepting.data()), accepting.size() * sizeof(std::uint64_t));
+}
+
+void MappedDFA::save(const DenseDFA& dfa, const std::string& path)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if(!file)
+		throw std::invalid_argument("Cannot open " + path);
+	write(dfa, file);
+	file.close();
+	if(!file)
+		throw std::invalid_argument("Cannot write " + path);
+}
+
+} /* namespace Automata */
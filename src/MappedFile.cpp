@@ -0,0 +1,53 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Automata {
+
+MappedFile::MappedFile(const std::string& path)
+:_data(nullptr), _size(0)
+{
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	if(descriptor < 0)
+		throw std::invalid_argument("Cannot open " + path + ": " + std::strerror(errno));
+
+	struct stat status;
+	if(::fstat(descriptor, &status) != 0)
+	{
+		const int error = errno;
+		::close(descriptor);
+		throw std::invalid_argument("Cannot stat " + path + ": " + std::strerror(error));
+	}
+
+	_size = static_cast<size_t>(status.st_size);
+	if(_size > 0)
+	{
+		void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(data == MAP_FAILED)
+		{
+			const int error = errno;
+			::close(descriptor);
+			throw std::invalid_argument("Cannot map " + path + ": " + std::strerror(error));
+		}
+		// Scans run front to back, let the kernel read ahead aggressively
+		::madvise(data, _size, MADV_SEQUENTIAL);
+		_data = static_cast<const char*>(data);
+	}
+	// The mapping stays valid after the descriptor is closed
+	::close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+	if(_data != nullptr)
+		::munmap(const_cast<char*>(_data), _size);
+}
+
+} /* namespace Automata */
@@ -27,6 +27,11 @@ StateSetType NFA::getFinalStates()
 	return const_cast<StateSetType&>(static_cast<const NFA&>(*this).getFinalStates());
 }
 
+size_t NFA::getNumberOfStates() const
+{
+	return _transitions.getNumberOfStates();
+}
+
 const StateSetType& NFA::move(const StateType& startState, const SymbolType& symbol) const
 {
 	return _transitions.getTransition(startState, symbol);
@@ -37,6 +42,16 @@ StateSetType NFA::move(const StateType& startState, const SymbolType& symbol)
 	return _transitions.getTransition(startState, symbol);
 }
 
+const StateSetType& NFA::move(const StateType& startState, const SymbolIdType& symbol) const
+{
+	return _transitions.getTransition(startState, symbol);
+}
+
+const std::vector<SymbolIdType>& NFA::getSymbolIds() const
+{
+	return _transitions.getSymbolIds();
+}
+
 TransitionTable::TransitionIteratorTag NFA::getTransitions(const StateType& state) const
 {
 	return this->_transitions.getTransitions(state);
@@ -65,39 +80,63 @@ TransitionTable::StateIterator end(const NFA& nfa)
 
 // EpsilonClosure
 EpsilonClosure::EpsilonClosure(const NFA& nfa)
+:_mapping(nfa.getNumberOfStates(), StateBitSet(nfa.getNumberOfStates())), _numberOfStates(nfa.getNumberOfStates())
 {
+	std::vector<StateType> unprocessedStates;
 	for(const auto& state: nfa)
 	{
-		const StateSetType closure = calculateClosure(nfa, state);
-		_mapping[state] = closure;
+		StateBitSet& closure = _mapping[state];
+		closure.insert(state);
+		unprocessedStates.push_back(state);
+		while(!unprocessedStates.empty())
+		{
+			const StateType current = unprocessedStates.back();
+			unprocessedStates.pop_back();
+			for(const auto& nextState: nfa.move(current, EpsilonId))
+				if(!closure.contains(nextState))
+				{
+					closure.insert(nextState);
+					unprocessedStates.push_back(nextState);
+				}
+		}
 	}
 }
 
-const StateSetType& EpsilonClosure::getClosure(const StateType& state) const
+const StateBitSet& EpsilonClosure::getClosureBits(const StateType& state) const
 {
-	if(_mapping.find(state) == std::end(_mapping))
+	if(state >= _mapping.size())
 		throw std::invalid_argument("Invalid state");
-	return _mapping.find(state)->second;
+	return _mapping[state];
 }
 
-StateSetType EpsilonClosure::getClosure(const StateType& state)
+StateSetType EpsilonClosure::getClosure(const StateType& state) const
 {
-	return const_cast<StateSetType&>(static_cast<const EpsilonClosure&>(*this).getClosure(state));
+	return getClosureBits(state).toStateSet();
 }
 
 StateSetType EpsilonClosure::getClosure(const StateSetType& states) const
 {
-	StateSetType closures;
-	for(const auto& state: states)
-	{
-		const auto closure = getClosure(state);
-		for(const auto& state: closure)
-			closures.insert(state);
-	}
+	return getClosure(StateBitSet(_numberOfStates, states)).toStateSet();
+}
 
+StateBitSet EpsilonClosure::getClosure(const StateBitSet& states) const
+{
+	StateBitSet closures(_numberOfStates);
+	getClosure(states, closures);
 	return closures;
 }
 
+void EpsilonClosure::getClosure(const StateBitSet& states, StateBitSet& closures) const
+{
+	closures.clear();
+	states.forEach([this, &closures](const StateType& state)
+	{
+		// States already present came in with a closure that contains their own
+		if(!closures.contains(state))
+			closures |= _mapping[state];
+	});
+}
+
 StateSetType EpsilonClosure::calculateClosure(const NFA& nfa, const StateType& initialState)
 {
 	StateSetType alreadyProcessed;
@@ -111,7 +150,7 @@ StateSetType EpsilonClosure::calculateClosure(const NFA& nfa, const StateType& i
 		const StateType state = unprocessedStates.front();
 		unprocessedStates.pop();
 		alreadyProcessed.insert(state);
-		for(const auto& nextState: nfa.move(state, Epsilon))
+		for(const auto& nextState: nfa.move(state, EpsilonId))
 		{
 			if(alreadyProcessed.find(nextState) == std::end(alreadyProcessed))
 				{
@@ -124,48 +163,76 @@ StateSetType EpsilonClosure::calculateClosure(const NFA& nfa, const StateType& i
 }
 
 NFARunner::NFARunner(const NFA& nfa)
-:_nfa(nfa)
+:_nfa(nfa), _accepting(nfa.getNumberOfStates(), false),
+ _currentStates(nfa.getNumberOfStates()), _nextStates(nfa.getNumberOfStates())
 {
+	const EpsilonClosure closure(_nfa);
+
+	_closureOffsets.push_back(0);
+	_edgeOffsets.push_back(0);
+	for(const auto& state: _nfa)
+	{
+		closure.getClosureBits(state).forEach([this](const StateType& closureState){ _closureStates.push_back(closureState); });
+		_closureOffsets.push_back(_closureStates.size());
+
+		for(const auto& transition: _nfa.getTransitions(state))
+		{
+			const SymbolType& symbol = transition.first;
+			// Only single byte symbols can be reached from a byte string
+			if(symbol == Epsilon || symbol.size() != 1)
+				continue;
+			for(const auto& target: transition.second)
+			{
+				_edgeBytes.push_back(static_cast<unsigned char>(symbol[0]));
+				_edgeTargets.push_back(target);
+			}
+		}
+		_edgeOffsets.push_back(_edgeTargets.size());
+	}
+
+	for(const auto& finalState: _nfa.getFinalStates())
+		_accepting[finalState] = true;
 }
 
 bool NFARunner::run(const std::string& input)
 {
-	const StateSetType& finalStates = _nfa.getFinalStates();
-	EpsilonClosure closure(_nfa);
+	SparseStateSet* currentStates = &_currentStates;
+	SparseStateSet* nextStates = &_nextStates;
 
-	StateSetType currentStates = closure.getClosure(_nfa.getInitialState());
+	currentStates->clear();
+	addClosure(*currentStates, _nfa.getInitialState());
 
 	for(const char& c: input)
 	{
-		const std::string symbol(1, c);
-		StateSetType nextStates;
-		for(const auto& currentState: currentStates)
-		{
-			try
-			{
-				const StateSetType transition = _nfa.move(currentState, static_cast<SymbolType>(symbol));
-				nextStates.insert(std::begin(transition), std::end(transition));
-				for(const auto& nextState: transition)
-				{
-					const StateSetType nextStateClosure = closure.getClosure(nextState);
-					nextStates.insert(std::begin(nextStateClosure), std::end(nextStateClosure));
-				}
-			}
-			catch(std::invalid_argument& e)
-			{
-				return false;
-			}
-		}
-		currentStates = nextStates;
+		const auto byte = static_cast<unsigned char>(c);
+		nextStates->clear();
+		for(const auto& currentState: *currentStates)
+			for(size_t edge = _edgeOffsets[currentState]; edge < _edgeOffsets[currentState + 1]; edge++)
+				if(_edgeBytes[edge] == byte)
+					addClosure(*nextStates, _edgeTargets[edge]);
+
+		// Every thread died, the remaining input can not be accepted
+		if(nextStates->empty())
+			return false;
+		std::swap(currentStates, nextStates);
 	}
 
-	return finalStateReached(currentStates, finalStates);
+	return finalStateReached(*currentStates);
+}
+
+void NFARunner::addClosure(SparseStateSet& states, const StateType& state) const
+{
+	// A closure is already complete once its source state is in the set
+	if(states.contains(state))
+		return;
+	for(size_t i = _closureOffsets[state]; i < _closureOffsets[state + 1]; i++)
+		states.insert(_closureStates[i]);
 }
 
-bool NFARunner::finalStateReached(const StateSetType& currentStates, const StateSetType& finalStates) const
+bool NFARunner::finalStateReached(const SparseStateSet& currentStates) const
 {
-	for(const auto& finalState: finalStates)
-		if(currentStates.find(finalState) != std::end(currentStates))
+	for(const auto& state: currentStates)
+		if(_accepting[state])
 			return true;
 	return false;
 }
@@ -0,0 +1,105 @@
+#include "ParallelMatcher.h"
+
+#include <algorithm>
+
+namespace Automata {
+
+ParallelMatcher::ParallelMatcher(const DenseDFA& dfa, const size_t& numberOfThreads)
+:_dfa(dfa), _pool(numberOfThreads)
+{
+}
+
+ParallelMatcher::IndexType ParallelMatcher::run(const char* input, size_t length, IndexType state) const
+{
+	const size_t numberOfChunks = std::min(_pool.size(), length / MinimumChunkSize);
+	if(numberOfChunks <= 1)
+		return _dfa.run(input, length, state);
+
+	const size_t chunkSize = (length + numberOfChunks - 1) / numberOfChunks;
+	std::vector<IndexType> firstState(1, state);
+	std::vector<std::vector<IndexType>> maps(numberOfChunks);
+	_pool.run(numberOfChunks, [&](size_t chunk)
+	{
+		const size_t begin = chunk * chunkSize;
+		const size_t size = std::min(chunkSize, length - begin);
+		if(chunk == 0)
+			firstState[0] = _dfa.run(input, size, state);
+		else
+			maps[chunk] = mapChunk(input + begin, size);
+	});
+
+	state = firstState[0];
+	for(size_t chunk = 1; chunk < numberOfChunks; chunk++)
+	{
+		const size_t begin = chunk * chunkSize;
+		if(maps[chunk].empty())
+			state = _dfa.run(input + begin, std::min(chunkSize, length - begin), state);
+		else
+			state = maps[chunk][state];
+	}
+	return state;
+}
+
+bool ParallelMatcher::matches(const char* input, size_t length) const
+{
+	return _dfa.isAccepting(run(input, length, _dfa.getInitialState()));
+}
+
+std::vector<ParallelMatcher::IndexType> ParallelMatcher::mapChunk(const char* input, size_t length) const
+{
+	const IndexType numberOfStates = static_cast<IndexType>(_dfa.getNumberOfStates());
+	const IndexType deadState = _dfa.getDeadState();
+
+	// Every start state points at one of the distinct paths still being followed
+	std::vector<IndexType> paths;
+	std::vector<size_t> pathOf(numberOfStates);
+	for(IndexType state = 0; state < numberOfStates; state++)
+	{
+		pathOf[state] = paths.size();
+		paths.push_back(state);
+	}
+
+	// Paths advance a block at a time so each block is read from cache, then merge
+	const size_t blockSize = 256;
+	const size_t noPath = static_cast<size_t>(-1);
+	std::vector<size_t> pathOfState(numberOfStates, noPath);
+	std::vector<size_t> newPath;
+	std::vector<IndexType> merged;
+	for(size_t offset = 0; offset < length; offset += blockSize)
+	{
+		const size_t size = std::min(blockSize, length - offset);
+		for(auto& path: paths)
+			if(path != deadState)
+				path = _dfa.run(input + offset, size, path);
+
+		merged.clear();
+		newPath.resize(paths.size());
+		for(size_t path = 0; path < paths.size(); path++)
+		{
+			const IndexType state = paths[path];
+			if(pathOfState[state] == noPath)
+			{
+				pathOfState[state] = merged.size();
+				merged.push_back(state);
+			}
+			newPath[path] = pathOfState[state];
+		}
+		for(const auto& state: merged)
+			pathOfState[state] = noPath;
+		if(merged.size() > MaxPaths)
+			return std::vector<IndexType>();
+		if(merged.size() == paths.size())
+			continue;
+
+		for(auto& path: pathOf)
+			path = newPath[path];
+		paths.swap(merged);
+	}
+
+	std::vector<IndexType> map(numberOfStates);
+	for(IndexType state = 0; state < numberOfStates; state++)
+		map[state] = paths[pathOf[state]];
+	return map;
+}
+
+} /* namespace Automata */
@@ -0,0 +1,74 @@
+#include "PatternSet.h"
+
+#include "RegexParser.h"
+#include "Thompson.h"
+#include "Powerset.h"
+#include "Hopcroft.h"
+#include "SymbolTable.h"
+
+namespace Automata {
+
+PatternSet::PatternSet(const std::vector<std::string>& regexes)
+:_numberOfPatterns(regexes.size()), _patterns(), _dense(compile(regexes, _patterns))
+{
+	// The dead state of the DenseDFA accepts nothing
+	_patterns.emplace_back();
+}
+
+const PatternSetType& PatternSet::match(const std::string& input) const
+{
+	return _patterns[_dense.run(input.data(), input.size(), _dense.getInitialState())];
+}
+
+NFA PatternSet::unite(const std::vector<NFA>& nfas, std::vector<PatternSetType>& patterns)
+{
+	// State 0 branches into every pattern, pattern states follow shifted by an offset
+	const StateType startState = 0;
+	TransitionTable transitionTable;
+	transitionTable.addState();
+	transitionTable.addSymbol(EpsilonId);
+	patterns.assign(1, PatternSetType());
+
+	StateSetType finalStates;
+	for(PatternIdType pattern = 0; pattern < nfas.size(); pattern++)
+	{
+		const NFA& nfa = nfas[pattern];
+		const StateType offset = static_cast<StateType>(transitionTable.getNumberOfStates());
+		for(size_t state = 0; state < nfa.getNumberOfStates(); state++)
+			transitionTable.addState();
+		patterns.resize(transitionTable.getNumberOfStates());
+
+		transitionTable.addTransition(startState, EpsilonId, nfa.getInitialState() + offset);
+		for(const auto& state: nfa)
+			for(const auto& transition: nfa.getTransitions(state))
+			{
+				const SymbolIdType symbol = SymbolTable::intern(transition.first);
+				transitionTable.addSymbol(symbol);
+				for(const auto& target: transition.second)
+					transitionTable.addTransition(state + offset, symbol, target + offset);
+			}
+		for(const auto& finalState: nfa.getFinalStates())
+		{
+			finalStates.insert(finalState + offset);
+			patterns[finalState + offset].push_back(pattern);
+		}
+	}
+
+	return NFA(transitionTable, startState, finalStates);
+}
+
+DFA PatternSet::compile(const std::vector<std::string>& regexes, std::vector<PatternSetType>& minimalPatterns)
+{
+	std::vector<NFA> nfas;
+	for(const auto& regex: regexes)
+		nfas.push_back(Thompson::apply(RegexParser::parse(regex)));
+
+	std::vector<PatternSetType> patterns;
+	const NFA nfa = unite(nfas, patterns);
+
+	std::vector<PatternSetType> dfaPatterns;
+	const DFA dfa = Powerset::apply(nfa, patterns, dfaPatterns);
+	return Hopcroft::apply(dfa, dfaPatterns, minimalPatterns);
+}
+
+} /* namespace Automata */
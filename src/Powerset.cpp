@@ -1,53 +1,259 @@
 #include "Powerset.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+#include "ConcurrentSubsetTable.h"
+
 namespace Automata {
 
 DFA Powerset::apply(const NFA& nfa)
 {
-	using DFAStatesSet = std::set<StateSetType>;
-	using DFAStatesQueue = std::queue<StateSetType>;
+	std::vector<PatternSetType> dfaPatterns;
+	return build(nfa, false, finalStatePatterns(nfa), dfaPatterns);
+}
+
+DFA Powerset::applyUnanchored(const NFA& nfa)
+{
+	std::vector<PatternSetType> dfaPatterns;
+	return build(nfa, true, finalStatePatterns(nfa), dfaPatterns);
+}
+
+DFA Powerset::apply(const NFA& nfa, const std::vector<PatternSetType>& patterns, std::vector<PatternSetType>& dfaPatterns)
+{
+	if(patterns.size() != nfa.getNumberOfStates())
+		throw std::invalid_argument("Expected one pattern set per state");
+	return build(nfa, false, patterns, dfaPatterns);
+}
 
-	const AlphabetType alphabet = getAlphabet(nfa);
+DFA Powerset::build(const NFA& nfa, const bool& unanchored, const std::vector<PatternSetType>& patterns,
+		std::vector<PatternSetType>& dfaPatterns)
+{
+	// Symbols of the same class move every subset to the same place
+	const std::vector<std::vector<SymbolIdType>> classSymbols = getClassSymbols(nfa);
+	const size_t numberOfClasses = classSymbols.size();
 
-	DFABuilder<StateSetType> builder;
 	EpsilonClosure closure(nfa);
 
-	const StateSetType sourceClosure = closure.getClosure(nfa.getInitialState());
+	const StateBitSet initialClosure = closure.getClosureBits(nfa.getInitialState());
+	SubsetTable dfaStates(nfa.getNumberOfStates());
+	dfaStates.intern(initialClosure);
 
-	DFAStatesSet dfaStates;
-	dfaStates.insert(sourceClosure);
+	// Ids are handed out in discovery order, so walking them in order is a breadth first search
+	std::vector<SubsetTable::IdType> targets;
+	StateBitSet dfaState(nfa.getNumberOfStates());
+	StateBitSet moved(nfa.getNumberOfStates());
+	StateBitSet nextDFAState(nfa.getNumberOfStates());
+	dfaPatterns.clear();
+	for(SubsetTable::IdType id = 0; id < dfaStates.size(); id++)
+	{
+		dfaStates.getSubset(id, dfaState);
+		for(SymbolClasses::ClassType symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+		{
+			multipleMove(nfa, dfaState, classSymbols[symbolClass].front(), moved);
+			closure.getClosure(moved, nextDFAState);
+			if(unanchored)
+				nextDFAState |= initialClosure;
+			targets.push_back(dfaStates.intern(nextDFAState).first);
+		}
+		dfaPatterns.emplace_back();
+		mergePatterns(dfaState, patterns, dfaPatterns.back());
+	}
 
-	DFAStatesQueue dfaStatesToProcess;
-	dfaStatesToProcess.push(sourceClosure);
-	while(!dfaStatesToProcess.empty())
+	return makeDFA(classSymbols, targets, dfaPatterns);
+}
+
+DFA Powerset::applyParallel(const NFA& nfa, ThreadPool& pool)
+{
+	struct WorkItem
+	{
+		SubsetTable::IdType id;
+		StateBitSet subset;
+	};
+	struct WorkQueue
 	{
-		const auto dfaState = dfaStatesToProcess.front();
-		dfaStatesToProcess.pop();
+		std::mutex mutex;
+		std::deque<WorkItem> items;
+	};
+	struct Result
+	{
+		SubsetTable::IdType id;
+		bool accepting;
+		std::vector<SubsetTable::IdType> targets;
+	};
+
+	const std::vector<std::vector<SymbolIdType>> classSymbols = getClassSymbols(nfa);
+	const size_t numberOfClasses = classSymbols.size();
+	const EpsilonClosure closure(nfa);
+	const StateBitSet finalStates(nfa.getNumberOfStates(), nfa.getFinalStates());
+
+	ConcurrentSubsetTable dfaStates(nfa.getNumberOfStates());
+	std::vector<WorkQueue> queues(pool.size());
+	std::vector<std::vector<Result>> results(pool.size());
+	// pending counts subsets queued or being expanded, queued only those in a deque
+	std::atomic<size_t> pending(1);
+	std::atomic<size_t> queued(1);
+	const StateBitSet& initialClosure = closure.getClosureBits(nfa.getInitialState());
+	queues[0].items.push_back({dfaStates.intern(initialClosure).first, initialClosure});
 
-		StateSetType sources;
-		for(const auto& symbol: alphabet)
+	// Idle workers sleep until a subset is queued, the last one is done or a worker failed.
+	// The first error stops everyone and is rethrown once the pool returns.
+	std::mutex idleMutex;
+	std::condition_variable idle;
+	std::atomic<bool> failed(false);
+	std::exception_ptr error;
+	const auto wake = [&idleMutex, &idle](const bool& all)
+	{
+		{ std::lock_guard<std::mutex> lock(idleMutex); }
+		if(all)
+			idle.notify_all();
+		else
+			idle.notify_one();
+	};
+
+	// Owners take the newest subset from the back, idle workers steal the oldest from the front
+	pool.run(pool.size(), [&](size_t worker)
+	{
+		StateBitSet moved(nfa.getNumberOfStates());
+		StateBitSet nextDFAState(nfa.getNumberOfStates());
+		WorkItem item;
+		while(pending > 0 && !failed)
 		{
-			const auto nextDFAState = closure.getClosure(multipleMove(nfa, dfaState, symbol));
-			if(dfaStates.find(nextDFAState) == std::end(dfaStates))
+			bool found = false;
+			for(size_t i = 0; i < queues.size() && !found; i++)
 			{
-				dfaStates.insert(nextDFAState);
-				dfaStatesToProcess.push(nextDFAState);
+				WorkQueue& queue = queues[(worker + i) % queues.size()];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				if(queue.items.empty())
+					continue;
+				if(i == 0)
+				{
+					item = std::move(queue.items.back());
+					queue.items.pop_back();
+				}
+				else
+				{
+					item = std::move(queue.items.front());
+					queue.items.pop_front();
+				}
+				queued--;
+				found = true;
 			}
-			builder.addTransition(dfaState, symbol, nextDFAState);
+			if(!found)
+			{
+				std::unique_lock<std::mutex> lock(idleMutex);
+				idle.wait(lock, [&]{ return queued > 0 || pending == 0 || failed; });
+				continue;
+			}
+
+			try
+			{
+				Result result{item.id, item.subset.intersects(finalStates), std::vector<SubsetTable::IdType>(numberOfClasses)};
+				for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+				{
+					multipleMove(nfa, item.subset, classSymbols[symbolClass].front(), moved);
+					closure.getClosure(moved, nextDFAState);
+					const auto target = dfaStates.intern(nextDFAState);
+					result.targets[symbolClass] = target.first;
+					if(target.second)
+					{
+						pending++;
+						{
+							std::lock_guard<std::mutex> lock(queues[worker].mutex);
+							queues[worker].items.push_back({target.first, nextDFAState});
+							queued++;
+						}
+						wake(false);
+					}
+				}
+				results[worker].push_back(std::move(result));
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(idleMutex);
+				if(!error)
+					error = std::current_exception();
+				failed = true;
+			}
+			if(--pending == 0 || failed)
+				wake(true);
 		}
+	});
+	if(error)
+		std::rethrow_exception(error);
+
+	// Ids depend on timing, renumbering breadth first from the initial subset gives the
+	// same DFA as the sequential construction
+	const size_t numberOfStates = dfaStates.size();
+	std::vector<const Result*> resultOf(numberOfStates);
+	for(const auto& workerResults: results)
+		for(const auto& result: workerResults)
+			resultOf[result.id] = &result;
+
+	const SubsetTable::IdType unnumbered = static_cast<SubsetTable::IdType>(-1);
+	std::vector<SubsetTable::IdType> numbering(numberOfStates, unnumbered);
+	std::vector<SubsetTable::IdType> order({0});
+	numbering[0] = 0;
+	for(size_t i = 0; i < order.size(); i++)
+		for(const auto& target: resultOf[order[i]]->targets)
+			if(numbering[target] == unnumbered)
+			{
+				numbering[target] = static_cast<SubsetTable::IdType>(order.size());
+				order.push_back(target);
+			}
+
+	std::vector<SubsetTable::IdType> targets;
+	std::vector<PatternSetType> dfaPatterns;
+	for(const auto& id: order)
+	{
+		for(const auto& target: resultOf[id]->targets)
+			targets.push_back(numbering[target]);
+		dfaPatterns.push_back(resultOf[id]->accepting ? PatternSetType{0} : PatternSetType());
 	}
 
-	builder.setInitialStateLabel(sourceClosure);
+	return makeDFA(classSymbols, targets, dfaPatterns);
+}
+
+std::vector<std::vector<SymbolIdType>> Powerset::getClassSymbols(const NFA& nfa)
+{
+	const SymbolClasses classes(nfa);
+	std::vector<std::vector<SymbolIdType>> classSymbols;
+	for(SymbolClasses::ClassType symbolClass = 0; symbolClass < classes.getNumberOfClasses(); symbolClass++)
+		classSymbols.push_back(classes.getSymbolIds(symbolClass));
+	return classSymbols;
+}
+
+DFA Powerset::makeDFA(const std::vector<std::vector<SymbolIdType>>& classSymbols, const std::vector<SubsetTable::IdType>& targets,
+		const std::vector<PatternSetType>& dfaPatterns)
+{
+	const size_t numberOfClasses = classSymbols.size();
 
-	for(const auto& dfaState: dfaStates)
-		if(containsAFinalState(dfaState, nfa.getFinalStates()))
-			builder.addFinalStateLabel(dfaState);
+	TransitionTable transitionTable;
+	for(size_t id = 0; id < dfaPatterns.size(); id++)
+		transitionTable.addState();
+	for(const auto& symbols: classSymbols)
+		for(const auto& symbol: symbols)
+			transitionTable.addSymbol(symbol);
 
-	return builder.build();
+	StateSetType dfaFinalStates;
+	for(SubsetTable::IdType id = 0; id < dfaPatterns.size(); id++)
+	{
+		for(size_t symbolClass = 0; symbolClass < numberOfClasses; symbolClass++)
+			for(const auto& symbol: classSymbols[symbolClass])
+				transitionTable.addTransition(id, symbol, targets[id * numberOfClasses + symbolClass]);
+		if(!dfaPatterns[id].empty())
+			dfaFinalStates.insert(id);
+	}
 
+	return DFA(NFA(transitionTable, 0, dfaFinalStates));
 }
 
-StateSetType Powerset::moveOverSet(const NFA& nfa, const StateSetType& sources, const SymbolType& symbol)
+StateSetType Powerset::moveOverSet(const NFA& nfa, const StateSetType& sources, const SymbolIdType& symbol)
 {
 	StateSetType targets;
 	for(const auto& source: sources)
@@ -60,39 +266,32 @@ StateSetType Powerset::moveOverSet(const NFA& nfa, const StateSetType& sources,
 	return targets;
 }
 
-AlphabetType Powerset::getAlphabet(const NFA& nfa)
+void Powerset::multipleMove(const NFA& nfa, const StateBitSet& sources, const SymbolIdType& symbol, StateBitSet& targets)
 {
-	AlphabetType alphabet;
-
-	for(const auto& state: nfa)
-		for(const auto& p: nfa.getTransitions(state))
-		{
-			const SymbolType symbol = p.first;
-			if(symbol != Epsilon)
-				alphabet.insert(symbol);
-		}
-
-	return alphabet;
+	targets.clear();
+	sources.forEach([&nfa, &symbol, &targets](const StateType& state)
+	{
+		for(const auto& target: nfa.move(state, symbol))
+			targets.insert(target);
+	});
 }
 
-StateSetType Powerset::multipleMove(const NFA& nfa, const StateSetType& sources, const SymbolType& symbol)
+void Powerset::mergePatterns(const StateBitSet& states, const std::vector<PatternSetType>& patterns, PatternSetType& merged)
 {
-	StateSetType targets;
-	for(const auto& state: sources)
+	states.forEach([&patterns, &merged](const StateType& state)
 	{
-		const auto singleSourceTargets = nfa.move(state, symbol);
-		for(const auto& state: singleSourceTargets)
-			targets.insert(state);
-	}
-	return targets;
+		merged.insert(std::end(merged), std::begin(patterns[state]), std::end(patterns[state]));
+	});
+	std::sort(std::begin(merged), std::end(merged));
+	merged.erase(std::unique(std::begin(merged), std::end(merged)), std::end(merged));
 }
 
-bool Powerset::containsAFinalState(const StateSetType& states, const StateSetType& finalStates)
+std::vector<PatternSetType> Powerset::finalStatePatterns(const NFA& nfa)
 {
-	for(const auto& finalState: finalStates)
-		if(states.find(finalState) != std::end(states))
-			return true;
-	return false;
+	std::vector<PatternSetType> patterns(nfa.getNumberOfStates());
+	for(const auto& finalState: nfa.getFinalStates())
+		patterns[finalState] = {0};
+	return patterns;
 }
 
 } /* namespace Automata */
@@ -0,0 +1,125 @@
+#include "Prefilter.h"
+
+#include <cstring>
+
+#include "SymbolTable.h"
+
+namespace Automata {
+
+Prefilter::Prefilter(const RegexAST& ast)
+:_prefix(), _suffix(), _factor()
+{
+	if(ast.getRoot() == RegexAST::NoNode)
+		return;
+
+	const Literals literals = ast.evaluate<Literals>([](const RegexAST::Node& node, const Literals* left, const Literals* right)
+	{
+		switch(node.kind)
+		{
+		case RegexAST::Kind::Symbol: return symbol(node.symbol);
+		case RegexAST::Kind::Concatenation: return concatenation(*left, *right);
+		case RegexAST::Kind::Alternative: return alternative(*left, *right);
+		case RegexAST::Kind::Epsilon: return Literals{true, "", "", ""};
+		default: return Literals{false, "", "", ""};
+		}
+	});
+	_prefix = literals.prefix;
+	_suffix = literals.suffix;
+	_factor = literals.factor;
+	_searchFactor = !_factor.empty() && _factor != _prefix && _factor != _suffix;
+}
+
+Prefilter::Prefilter(const std::string& prefix, const std::string& suffix, const std::string& factor)
+:_prefix(prefix), _suffix(suffix), _factor(factor), _searchFactor(!factor.empty() && factor != prefix && factor != suffix)
+{
+}
+
+bool Prefilter::mayMatch(const char* input, size_t length) const
+{
+	if(length < _prefix.size() || length < _suffix.size() || length < _factor.size())
+		return false;
+	if(std::memcmp(input, _prefix.data(), _prefix.size()) != 0)
+		return false;
+	if(std::memcmp(input + length - _suffix.size(), _suffix.data(), _suffix.size()) != 0)
+		return false;
+	return !_searchFactor || findFactor(input, input + length) != input + length;
+}
+
+const char* Prefilter::findFactor(const char* begin, const char* end) const
+{
+	return find(begin, end, _factor);
+}
+
+const char* Prefilter::find(const char* begin, const char* end, const std::string& literal)
+{
+	if(literal.empty())
+		return begin;
+
+	// memchr skips to candidates for the first byte, memcmp confirms the rest
+	const char* iter = begin;
+	while(static_cast<size_t>(end - iter) >= literal.size())
+	{
+		const void* candidate = std::memchr(iter, literal.front(), end - iter - literal.size() + 1);
+		if(candidate == nullptr)
+			break;
+		iter = static_cast<const char*>(candidate);
+		if(std::memcmp(iter + 1, literal.data() + 1, literal.size() - 1) == 0)
+			return iter;
+		iter++;
+	}
+	return end;
+}
+
+Prefilter::Literals Prefilter::symbol(const SymbolIdType& symbol)
+{
+	// Longer symbols are not single bytes, nothing is known about them
+	if(!SymbolTable::isByte(symbol))
+		return Literals{false, "", "", ""};
+	const std::string literal(1, static_cast<char>(symbol));
+	return Literals{true, literal, literal, literal};
+}
+
+Prefilter::Literals Prefilter::concatenation(const Literals& left, const Literals& right)
+{
+	Literals result;
+	result.exact = left.exact && right.exact;
+	result.prefix = left.exact ? left.prefix + right.prefix : left.prefix;
+	result.suffix = right.exact ? left.suffix + right.suffix : right.suffix;
+	if(result.exact)
+		result.factor = result.prefix;
+	else
+		result.factor = longest(longest(left.factor, right.factor), left.suffix + right.prefix);
+	return result;
+}
+
+Prefilter::Literals Prefilter::alternative(const Literals& left, const Literals& right)
+{
+	if(left.exact && right.exact && left.prefix == right.prefix)
+		return left;
+
+	Literals result;
+	result.exact = false;
+	size_t prefixLength = 0;
+	while(prefixLength < left.prefix.size() && prefixLength < right.prefix.size()
+			&& left.prefix[prefixLength] == right.prefix[prefixLength])
+		prefixLength++;
+	result.prefix = left.prefix.substr(0, prefixLength);
+
+	size_t suffixLength = 0;
+	while(suffixLength < left.suffix.size() && suffixLength < right.suffix.size()
+			&& left.suffix[left.suffix.size() - suffixLength - 1] == right.suffix[right.suffix.size() - suffixLength - 1])
+		suffixLength++;
+	result.suffix = left.suffix.substr(left.suffix.size() - suffixLength);
+
+	result.factor = longest(result.prefix, result.suffix);
+	if(left.factor == right.factor)
+		result.factor = longest(result.factor, left.factor);
+	return result;
+}
+
+const std::string& Prefilter::longest(const std::string& lhs, const std::string& rhs)
+{
+	return rhs.size() > lhs.size() ? rhs : lhs;
+}
+
+} /* namespace Automata */
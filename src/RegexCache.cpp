@@ -0,0 +1,148 @@
+#include "RegexCache.h"
+
+#include "RegexOptimizer.h"
+#include "Thompson.h"
+#include "Powerset.h"
+#include "Hopcroft.h"
+
+namespace Automata {
+
+RegexCache::RegexCache(const size_t& memoryBudget)
+:_memoryBudget(memoryBudget), _mutex(), _entries(), _index(), _memoryUsage(0), _hits(0), _misses(0), _evictions(0)
+{
+}
+
+RegexCache::DFAPointer RegexCache::get(const std::string& regex)
+{
+	return get(RegexParser::parse(regex));
+}
+
+RegexCache::DFAPointer RegexCache::get(const RegexAST& regex)
+{
+	// Optimized once, for the key and for the DFA
+	const RegexAST optimized = RegexOptimizer::apply(regex);
+	const std::string key = to_string(optimized);
+	const DFAPointer cached = find(key);
+	if(cached)
+		return cached;
+	// Compiled outside the lock, if another thread got there first its DFA is kept
+	return insert(key, std::make_shared<const DFA>(build(optimized)));
+}
+
+RegexCache::DFAPointer RegexCache::find(const RegexAST& regex)
+{
+	return find(normalize(regex));
+}
+
+RegexCache::DFAPointer RegexCache::find(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto iter = _index.find(key);
+	if(iter == std::end(_index))
+	{
+		_misses++;
+		return DFAPointer();
+	}
+	_hits++;
+	_entries.splice(std::begin(_entries), _entries, iter->second);
+	return iter->second->dfa;
+}
+
+RegexCache::DFAPointer RegexCache::insert(const RegexAST& regex, const DFA& dfa)
+{
+	return insert(normalize(regex), std::make_shared<const DFA>(dfa));
+}
+
+RegexCache::DFAPointer RegexCache::insert(const std::string& key, const DFAPointer& dfa)
+{
+	const size_t memory = estimateMemory(*dfa) + key.size();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto iter = _index.find(key);
+	if(iter != std::end(_index))
+	{
+		_entries.splice(std::begin(_entries), _entries, iter->second);
+		return iter->second->dfa;
+	}
+	// Larger than the whole budget, handed out without being cached
+	if(memory > _memoryBudget)
+		return dfa;
+
+	while(_memoryUsage + memory > _memoryBudget)
+	{
+		_memoryUsage -= _entries.back().memory;
+		_index.erase(_entries.back().key);
+		_entries.pop_back();
+		_evictions++;
+	}
+	_entries.push_front({key, dfa, memory});
+	_index.emplace(key, std::begin(_entries));
+	_memoryUsage += memory;
+	return dfa;
+}
+
+void RegexCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+	_index.clear();
+	_memoryUsage = 0;
+}
+
+size_t RegexCache::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _entries.size();
+}
+
+size_t RegexCache::getMemoryUsage() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _memoryUsage;
+}
+
+size_t RegexCache::getHits() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _hits;
+}
+
+size_t RegexCache::getMisses() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _misses;
+}
+
+size_t RegexCache::getEvictions() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _evictions;
+}
+
+std::string RegexCache::normalize(const RegexAST& regex)
+{
+	return to_string(RegexOptimizer::apply(regex));
+}
+
+DFA RegexCache::compile(const RegexAST& regex)
+{
+	return build(RegexOptimizer::apply(regex));
+}
+
+DFA RegexCache::build(const RegexAST& optimized)
+{
+	return Hopcroft::apply(Powerset::apply(Thompson::apply(optimized)));
+}
+
+size_t RegexCache::estimateMemory(const DFA& dfa)
+{
+	// Every transition table cell is a std::set, each target one tree node
+	const size_t nodeSize = sizeof(StateType) + 4 * sizeof(void*);
+	size_t memory = sizeof(DFA);
+	for(const auto& state: dfa)
+		for(const auto& transition: dfa.getTransitions(state))
+			memory += sizeof(StateSetType) + transition.second.size() * nodeSize;
+	return memory;
+}
+
+} /* namespace Automata */
@@ -0,0 +1,209 @@
+#include "RegexOptimizer.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+namespace Automata {
+
+static std::vector<RegexAST::NodeIdType> collectOperands(const RegexAST& ast, const RegexAST::NodeIdType& root, const RegexAST::Kind& kind)
+{
+	// Left to right operands of a chain of binary nodes of the same kind
+	std::vector<RegexAST::NodeIdType> operands;
+	std::vector<RegexAST::NodeIdType> pending({root});
+	while(!pending.empty())
+	{
+		const RegexAST::NodeIdType id = pending.back();
+		pending.pop_back();
+		const RegexAST::Node& node = ast.getNode(id);
+		if(node.kind == kind)
+		{
+			pending.push_back(node.right);
+			pending.push_back(node.left);
+		}
+		else
+			operands.push_back(id);
+	}
+	return operands;
+}
+
+RegexAST RegexOptimizer::apply(const RegexAST& input)
+{
+	RegexOptimizer optimizer(input);
+	if(input.getRoot() != RegexAST::NoNode)
+		optimizer._output.setRoot(optimizer.optimize(input.getRoot()));
+	return std::move(optimizer._output);
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::optimize(const NodeIdType& id)
+{
+	const RegexAST::Node& node = _input.getNode(id);
+	switch(node.kind)
+	{
+	case RegexAST::Kind::Concatenation: return optimizeConcatenation(id);
+	case RegexAST::Kind::Alternative: return optimizeAlternative(id);
+	case RegexAST::Kind::Kleene: return optimizeKleene(id);
+	default: return intern(node);
+	}
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::optimizeConcatenation(const NodeIdType& id)
+{
+	SequenceType sequence;
+	for(const auto& operand: collectOperands(_input, id, RegexAST::Kind::Concatenation))
+	{
+		const SequenceType operandSequence = getSequence(optimize(operand));
+		sequence.insert(std::end(sequence), std::begin(operandSequence), std::end(operandSequence));
+	}
+	return makeSequence(sequence, 0, sequence.size(), _input.getNode(id).position);
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::optimizeAlternative(const NodeIdType& id)
+{
+	std::vector<NodeIdType> branches;
+	for(const auto& operand: collectOperands(_input, id, RegexAST::Kind::Alternative))
+		for(const auto& branch: collectOperands(_output, optimize(operand), RegexAST::Kind::Alternative))
+			branches.push_back(branch);
+	return factor(branches, _input.getNode(id).position);
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::optimizeKleene(const NodeIdType& id)
+{
+	const RegexAST::Node& node = _input.getNode(id);
+	const NodeIdType child = optimize(node.left);
+	const RegexAST::Kind childKind = _output.getNode(child).kind;
+	if(childKind == RegexAST::Kind::Kleene || childKind == RegexAST::Kind::Epsilon)
+		return child;
+	return intern({RegexAST::Kind::Kleene, EpsilonId, child, RegexAST::NoNode, node.position});
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::factor(const std::vector<NodeIdType>& alternatives, const size_t& position)
+{
+	std::vector<NodeIdType> branches;
+	std::unordered_set<NodeIdType> seen;
+	for(const auto& branch: alternatives)
+		if(seen.insert(branch).second)
+			branches.push_back(branch);
+
+	// First common prefixes, then common suffixes of what is left
+	for(const bool& prefix: {true, false})
+	{
+		if(branches.size() == 1)
+			break;
+
+		std::vector<SequenceType> sequences;
+		std::vector<std::vector<size_t>> groups;
+		std::map<NodeIdType, size_t> groupOf;
+		for(const auto& branch: branches)
+		{
+			sequences.push_back(getSequence(branch));
+			const SequenceType& sequence = sequences.back();
+			if(sequence.empty())
+			{
+				groups.push_back({sequences.size() - 1});
+				continue;
+			}
+			const NodeIdType key = prefix ? sequence.front() : sequence.back();
+			const auto iter = groupOf.emplace(key, groups.size()).first;
+			if(iter->second == groups.size())
+				groups.emplace_back();
+			groups[iter->second].push_back(sequences.size() - 1);
+		}
+
+		std::vector<NodeIdType> factored;
+		for(const auto& group: groups)
+		{
+			if(group.size() == 1)
+			{
+				factored.push_back(branches[group.front()]);
+				continue;
+			}
+
+			std::vector<NodeIdType> rests;
+			for(const auto& index: group)
+			{
+				const SequenceType& sequence = sequences[index];
+				rests.push_back(prefix ? makeSequence(sequence, 1, sequence.size(), position)
+						: makeSequence(sequence, 0, sequence.size() - 1, position));
+			}
+
+			const NodeIdType common = prefix ? sequences[group.front()].front() : sequences[group.front()].back();
+			SequenceType sequence = getSequence(factor(rests, position));
+			if(prefix)
+				sequence.insert(std::begin(sequence), common);
+			else
+				sequence.push_back(common);
+			factored.push_back(makeSequence(sequence, 0, sequence.size(), position));
+		}
+		branches = factored;
+	}
+
+	return makeAlternatives(branches, position);
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::makeSequence(const SequenceType& sequence, const size_t& begin, const size_t& end,
+		const size_t& position)
+{
+	if(begin == end)
+		return makeEpsilon(position);
+	NodeIdType result = sequence[begin];
+	for(size_t i = begin + 1; i < end; i++)
+		result = intern({RegexAST::Kind::Concatenation, EpsilonId, result, sequence[i], position});
+	return result;
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::makeAlternatives(const std::vector<NodeIdType>& branches, const size_t& position)
+{
+	NodeIdType result = branches.front();
+	for(size_t i = 1; i < branches.size(); i++)
+		result = intern({RegexAST::Kind::Alternative, EpsilonId, result, branches[i], position});
+	return result;
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::makeEpsilon(const size_t& position)
+{
+	return intern({RegexAST::Kind::Epsilon, EpsilonId, RegexAST::NoNode, RegexAST::NoNode, position});
+}
+
+RegexOptimizer::NodeIdType RegexOptimizer::intern(const RegexAST::Node& node)
+{
+	const auto iter = _nodes.find(node);
+	if(iter != std::end(_nodes))
+		return iter->second;
+
+	NodeIdType id = RegexAST::NoNode;
+	switch(node.kind)
+	{
+	case RegexAST::Kind::Symbol: id = _output.addSymbol(node.symbol, node.position); break;
+	case RegexAST::Kind::Epsilon: id = _output.addEpsilon(node.position); break;
+	case RegexAST::Kind::Concatenation: id = _output.addConcatenation(node.left, node.right, node.position); break;
+	case RegexAST::Kind::Alternative: id = _output.addAlternative(node.left, node.right, node.position); break;
+	case RegexAST::Kind::Kleene: id = _output.addKleene(node.left, node.position); break;
+	}
+	_nodes.emplace(node, id);
+	return id;
+}
+
+RegexOptimizer::SequenceType RegexOptimizer::getSequence(const NodeIdType& id) const
+{
+	// Concatenations are always built left nested, # is the empty sequence
+	if(_output.getNode(id).kind == RegexAST::Kind::Epsilon)
+		return SequenceType();
+	return collectOperands(_output, id, RegexAST::Kind::Concatenation);
+}
+
+size_t RegexOptimizer::NodeHash::operator()(const RegexAST::Node& node) const
+{
+	size_t hash = static_cast<size_t>(node.kind);
+	hash = hash * 1000003u ^ node.symbol;
+	hash = hash * 1000003u ^ node.left;
+	hash = hash * 1000003u ^ node.right;
+	return hash;
+}
+
+bool RegexOptimizer::NodeEqual::operator()(const RegexAST::Node& lhs, const RegexAST::Node& rhs) const
+{
+	return lhs.kind == rhs.kind && lhs.symbol == rhs.symbol && lhs.left == rhs.left && lhs.right == rhs.right;
+}
+
+} /* namespace Automata */
@@ -0,0 +1,149 @@
+#include "RegexParser.h"
+
+#include "SymbolTable.h"
+
+namespace Automata {
+
+// RegexAST
+RegexAST::NodeIdType RegexAST::addSymbol(const SymbolIdType& symbol, const size_t& position)
+{
+	return addNode({Kind::Symbol, symbol, NoNode, NoNode, position});
+}
+
+RegexAST::NodeIdType RegexAST::addEpsilon(const size_t& position)
+{
+	return addNode({Kind::Epsilon, EpsilonId, NoNode, NoNode, position});
+}
+
+RegexAST::NodeIdType RegexAST::addConcatenation(const NodeIdType& left, const NodeIdType& right, const size_t& position)
+{
+	return addNode({Kind::Concatenation, EpsilonId, left, right, position});
+}
+
+RegexAST::NodeIdType RegexAST::addAlternative(const NodeIdType& left, const NodeIdType& right, const size_t& position)
+{
+	return addNode({Kind::Alternative, EpsilonId, left, right, position});
+}
+
+RegexAST::NodeIdType RegexAST::addKleene(const NodeIdType& child, const size_t& position)
+{
+	return addNode({Kind::Kleene, EpsilonId, child, NoNode, position});
+}
+
+RegexAST::NodeIdType RegexAST::addNode(const Node& node)
+{
+	_nodes.push_back(node);
+	return static_cast<NodeIdType>(_nodes.size() - 1);
+}
+
+// Prints the expression in the same postfix notation as ShuntingYard::SimpleAlgorithm
+std::ostream& operator<<(std::ostream& os, const RegexAST& ast)
+{
+	if(ast.getRoot() == RegexAST::NoNode)
+		return os;
+
+	std::vector<std::pair<RegexAST::NodeIdType, bool>> pending({{ast.getRoot(), false}});
+	while(!pending.empty())
+	{
+		const auto id = pending.back().first;
+		const bool childrenDone = pending.back().second;
+		pending.pop_back();
+		const auto& node = ast.getNode(id);
+
+		if(!childrenDone && node.left != RegexAST::NoNode)
+		{
+			pending.emplace_back(id, true);
+			if(node.right != RegexAST::NoNode)
+				pending.emplace_back(node.right, false);
+			pending.emplace_back(node.left, false);
+			continue;
+		}
+
+		switch(node.kind)
+		{
+		case RegexAST::Kind::Symbol: os << SymbolTable::getSymbol(node.symbol); break;
+		case RegexAST::Kind::Epsilon: os << Epsilon; break;
+		case RegexAST::Kind::Concatenation: os << '.'; break;
+		case RegexAST::Kind::Alternative: os << '|'; break;
+		case RegexAST::Kind::Kleene: os << '*'; break;
+		}
+	}
+	return os;
+}
+
+// RegexParser
+RegexAST RegexParser::parse(const std::string& input)
+{
+	RegexParser parser(input);
+	parser._ast.setRoot(parser.parseAlternative());
+	if(!parser.atEnd())
+		throw RegexParseError("Unexpected <" + std::string(1, parser.peek()) + ">", parser._position);
+	return std::move(parser._ast);
+}
+
+RegexAST::NodeIdType RegexParser::parseAlternative()
+{
+	RegexAST::NodeIdType left = parseConcatenation();
+	while(!atEnd() && peek() == '|')
+	{
+		const size_t position = _position++;
+		left = _ast.addAlternative(left, parseConcatenation(), position);
+	}
+	return left;
+}
+
+RegexAST::NodeIdType RegexParser::parseConcatenation()
+{
+	RegexAST::NodeIdType left = parseKleene();
+	while(!atEnd())
+	{
+		const size_t position = _position;
+		if(peek() == '.')
+			_position++;
+		else if(!startsAtom())
+			break;
+		left = _ast.addConcatenation(left, parseKleene(), position);
+	}
+	return left;
+}
+
+RegexAST::NodeIdType RegexParser::parseKleene()
+{
+	RegexAST::NodeIdType child = parseAtom();
+	while(!atEnd() && peek() == '*')
+		child = _ast.addKleene(child, _position++);
+	return child;
+}
+
+RegexAST::NodeIdType RegexParser::parseAtom()
+{
+	if(atEnd())
+		throw RegexParseError("Unexpected end of expression", _position);
+
+	const size_t position = _position;
+	const char c = peek();
+	if(c == '(')
+	{
+		_position++;
+		const RegexAST::NodeIdType inner = parseAlternative();
+		if(atEnd() || peek() != ')')
+			throw RegexParseError("Unbalanced <(>", position);
+		_position++;
+		return inner;
+	}
+	if(!startsAtom())
+		throw RegexParseError("Unexpected <" + std::string(1, c) + ">", position);
+
+	_position++;
+	if(c == EpsilonCharacter)
+		return _ast.addEpsilon(position);
+	return _ast.addSymbol(static_cast<unsigned char>(c), position);
+}
+
+bool RegexParser::startsAtom() const
+{
+	const char c = peek();
+	return c != '|' && c != ')' && c != '*' && c != '.';
+}
+
+} /* namespace Automata */
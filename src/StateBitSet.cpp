@@ -0,0 +1,32 @@
+#include "StateBitSet.h"
+
+namespace Automata {
+
+StateBitSet::StateBitSet(size_t capacity, const StateSetType& states)
+:StateBitSet(capacity)
+{
+	for(const auto& state: states)
+		insert(state);
+}
+
+size_t StateBitSet::count() const
+{
+	size_t total = 0;
+	for(const auto& word: _words)
+		total += __builtin_popcountll(word);
+	return total;
+}
+
+StateSetType StateBitSet::toStateSet() const
+{
+	StateSetType states;
+	forEach([&states](const StateType& state){ states.insert(std::end(states), state); });
+	return states;
+}
+
+std::ostream& operator<<(std::ostream& os, const StateBitSet& states)
+{
+	return os << states.toStateSet();
+}
+
+} /* namespace Automata */
@@ -0,0 +1,36 @@
+#include "StreamMatcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "MappedFile.h"
+
+namespace Automata {
+
+StreamMatcher::StreamMatcher(const DenseDFA& dfa)
+:_dfa(dfa), _state(dfa.getInitialState())
+{
+}
+
+void StreamMatcher::feed(const char* chunk, size_t length)
+{
+	// Blocks keep the inner loop tight while still stopping soon after the dead state
+	const size_t blockSize = 4096;
+	for(size_t offset = 0; offset < length && !isDead(); offset += blockSize)
+		_state = _dfa.run(chunk + offset, std::min(blockSize, length - offset), _state);
+}
+
+void StreamMatcher::feedFile(const std::string& path)
+{
+	const MappedFile file(path);
+	feed(file.data(), file.size());
+}
+
+void StreamMatcher::setState(const IndexType& state)
+{
+	if(state > _dfa.getDeadState())
+		throw std::invalid_argument("Invalid state " + std::to_string(state));
+	_state = state;
+}
+
+} /* namespace Automata */
@@ -0,0 +1,86 @@
+#include "SubsetTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Automata {
+
+SubsetTable::SubsetTable(size_t numberOfStates)
+:_numberOfStates(numberOfStates), _wordsPerSubset(StateBitSet(numberOfStates).getNumberOfWords()),
+ _arena(), _hashes(), _buckets(InitialBuckets, EmptyBucket)
+{
+}
+
+std::pair<SubsetTable::IdType, bool> SubsetTable::intern(const StateBitSet& subset)
+{
+	if(subset.getNumberOfWords() != _wordsPerSubset)
+		throw std::invalid_argument("Subset capacity does not match the table");
+
+	const size_t hash = subset.hash();
+	const size_t mask = _buckets.size() - 1;
+	size_t bucket = hash & mask;
+	while(_buckets[bucket] != EmptyBucket)
+	{
+		const IdType id = _buckets[bucket];
+		if(_hashes[id] == hash && equals(id, subset.data()))
+			return std::make_pair(id, false);
+		bucket = (bucket + 1) & mask;
+	}
+
+	const IdType id = static_cast<IdType>(size());
+	_arena.insert(std::end(_arena), subset.data(), subset.data() + _wordsPerSubset);
+	_hashes.push_back(hash);
+	_buckets[bucket] = id;
+
+	// Keep the load factor under one half
+	if(2 * size() > _buckets.size())
+		grow();
+
+	return std::make_pair(id, true);
+}
+
+StateBitSet SubsetTable::getSubset(const IdType& id) const
+{
+	StateBitSet subset(_numberOfStates);
+	getSubset(id, subset);
+	return subset;
+}
+
+void SubsetTable::getSubset(const IdType& id, StateBitSet& subset) const
+{
+	std::copy(getWords(id), getWords(id) + _wordsPerSubset, subset.data());
+}
+
+size_t SubsetTable::getMemoryUsage() const
+{
+	return _arena.size() * sizeof(WordType) + _hashes.size() * sizeof(size_t) + _buckets.size() * sizeof(IdType);
+}
+
+void SubsetTable::clear()
+{
+	_arena.clear();
+	_hashes.clear();
+	_buckets.assign(InitialBuckets, EmptyBucket);
+}
+
+void SubsetTable::grow()
+{
+	std::vector<IdType> buckets(2 * _buckets.size(), EmptyBucket);
+	const size_t mask = buckets.size() - 1;
+	for(IdType id = 0; id < size(); id++)
+	{
+		size_t bucket = _hashes[id] & mask;
+		while(buckets[bucket] != EmptyBucket)
+			bucket = (bucket + 1) & mask;
+		buckets[bucket] = id;
+	}
+	std::swap(_buckets, buckets);
+}
+
+bool SubsetTable::equals(const IdType& id, const WordType* words) const
+{
+	return _wordsPerSubset == 0 || std::memcmp(getWords(id), words, _wordsPerSubset * sizeof(WordType)) == 0;
+}
+
+} /* namespace Automata */
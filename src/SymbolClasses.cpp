@@ -0,0 +1,89 @@
+#include "SymbolClasses.h"
+
+#include <algorithm>
+#include <map>
+
+namespace Automata {
+
+SymbolClasses::SymbolClasses(const NFA& nfa)
+{
+	compute(nfa);
+}
+
+SymbolClasses::SymbolClasses(const DFA& dfa)
+{
+	compute(dfa);
+}
+
+SymbolClasses::ClassType SymbolClasses::getClass(const SymbolIdType& symbol) const
+{
+	const auto iter = _classOf.find(symbol);
+	if(iter == std::end(_classOf))
+		throw std::invalid_argument("Symbol " + SymbolTable::getSymbol(symbol) + " does not belong to the alphabet");
+	return iter->second;
+}
+
+SymbolClasses::ClassType SymbolClasses::getClass(const SymbolType& symbol) const
+{
+	SymbolIdType id;
+	if(!SymbolTable::find(symbol, id))
+		throw std::invalid_argument("Symbol " + symbol + " does not belong to the alphabet");
+	return getClass(id);
+}
+
+SymbolSetType SymbolClasses::getSymbols(const ClassType& symbolClass) const
+{
+	SymbolSetType symbols;
+	for(const auto& symbol: getSymbolIds(symbolClass))
+		symbols.insert(SymbolTable::getSymbol(symbol));
+	return symbols;
+}
+
+template <class AutomatonType>
+void SymbolClasses::compute(const AutomatonType& automaton)
+{
+	// Names are looked up once, only to order the symbols
+	std::vector<std::pair<SymbolType, SymbolIdType>> named;
+	for(const auto& symbol: automaton.getSymbolIds())
+		if(symbol != EpsilonId)
+			named.emplace_back(SymbolTable::getSymbol(symbol), symbol);
+	std::sort(std::begin(named), std::end(named));
+	std::vector<SymbolIdType> symbols;
+	for(const auto& p: named)
+		symbols.push_back(p.second);
+
+	// Start with a single class and split it by the targets of every state in turn
+	std::vector<ClassType> classOf(symbols.size(), 0);
+	for(const auto& state: automaton)
+	{
+		std::map<std::pair<ClassType, StateSetType>, ClassType> refinement;
+		for(size_t i = 0; i < symbols.size(); i++)
+		{
+			const auto key = std::make_pair(classOf[i], getTargets(automaton, state, symbols[i]));
+			classOf[i] = refinement.emplace(key, static_cast<ClassType>(refinement.size())).first->second;
+		}
+	}
+
+	// Renumber classes by their smallest symbol
+	std::unordered_map<ClassType, ClassType> numbering;
+	for(size_t i = 0; i < symbols.size(); i++)
+	{
+		const auto iter = numbering.emplace(classOf[i], static_cast<ClassType>(numbering.size())).first;
+		if(iter->second == _classes.size())
+			_classes.emplace_back();
+		_classes[iter->second].push_back(symbols[i]);
+		_classOf[symbols[i]] = iter->second;
+	}
+}
+
+const StateSetType& SymbolClasses::getTargets(const NFA& nfa, const StateType& state, const SymbolIdType& symbol)
+{
+	return nfa.move(state, symbol);
+}
+
+const StateSetType& SymbolClasses::getTargets(const DFA& dfa, const StateType& state, const SymbolIdType& symbol)
+{
+	return dfa.getTargets(state, symbol);
+}
+
+} /* namespace Automata */
@@ -0,0 +1,60 @@
+#include "SymbolTable.h"
+
+#include <stdexcept>
+
+namespace Automata {
+
+SymbolTable& SymbolTable::getInstance()
+{
+	static SymbolTable instance;
+	return instance;
+}
+
+SymbolIdType SymbolTable::intern(const SymbolType& symbol)
+{
+	if(symbol.empty())
+		throw std::invalid_argument("Empty symbol is not valid");
+	if(symbol.size() == 1)
+		return static_cast<unsigned char>(symbol[0]);
+
+	SymbolTable& table = getInstance();
+	std::lock_guard<std::mutex> lock(table._mutex);
+	const SymbolIdType id = static_cast<SymbolIdType>(FirstInternedId + table._symbols.size());
+	const auto result = table._ids.emplace(symbol, id);
+	if(result.second)
+		table._symbols.push_back(symbol);
+	return result.first->second;
+}
+
+bool SymbolTable::find(const SymbolType& symbol, SymbolIdType& id)
+{
+	if(symbol.empty())
+		return false;
+	if(symbol.size() == 1)
+	{
+		id = static_cast<unsigned char>(symbol[0]);
+		return true;
+	}
+
+	const SymbolTable& table = getInstance();
+	std::lock_guard<std::mutex> lock(table._mutex);
+	const auto iter = table._ids.find(symbol);
+	if(iter == std::end(table._ids))
+		return false;
+	id = iter->second;
+	return true;
+}
+
+SymbolType SymbolTable::getSymbol(const SymbolIdType& id)
+{
+	if(isByte(id))
+		return SymbolType(1, static_cast<char>(id));
+
+	const SymbolTable& table = getInstance();
+	std::lock_guard<std::mutex> lock(table._mutex);
+	if(id - FirstInternedId >= table._symbols.size())
+		throw std::invalid_argument("Unknown symbol id " + std::to_string(id));
+	return table._symbols[id - FirstInternedId];
+}
+
+} /* namespace Automata */
@@ -15,126 +15,234 @@ Automata::NFA Trivial::apply(const SymbolType& symbol)
 
 Automata::NFA Concatenation::apply(const NFA& first, const NFA& second)
 {
-	const std::string firstPrefix("_first");
-	const std::string secondPrefix("_second");
+	const StateType secondOffset = static_cast<StateType>(first.getNumberOfStates());
 
 	const StateType firstStartState = first.getInitialState();
 	const StateType firstEndState = *std::begin(first.getFinalStates());
-	const StateType secondStartState = second.getInitialState();
-	const StateType secondEndState = *std::begin(second.getFinalStates());
+	const StateType secondStartState = second.getInitialState() + secondOffset;
+	const StateType secondEndState = *std::begin(second.getFinalStates()) + secondOffset;
 
-	Automata::NFABuilder<std::string> builder;
+	Automata::NFABuilder<StateType> builder;
 
-	copyTransitions(builder, first, firstPrefix);
+	copyTransitions(builder, first);
 
-	builder.addTransition(firstPrefix+std::to_string(firstEndState), Epsilon, secondPrefix+std::to_string(secondStartState));
+	builder.addTransition(firstEndState, EpsilonId, secondStartState);
 
-	copyTransitions(builder, second, secondPrefix);
+	copyTransitions(builder, second, secondOffset);
 
-	builder.setInitialStateLabel(firstPrefix + std::to_string(firstStartState));
-	builder.addFinalStateLabel(secondPrefix + std::to_string(secondEndState));
+	builder.setInitialStateLabel(firstStartState);
+	builder.addFinalStateLabel(secondEndState);
 
 	return builder.build();
 }
 
 Automata::NFA Alternative::apply(const NFA& first, const NFA& second)
 {
-	const std::string firstPrefix("_first");
-	const std::string secondPrefix("_second");
+	const StateType firstOffset = 2;
+	const StateType secondOffset = firstOffset + static_cast<StateType>(first.getNumberOfStates());
 
-	const std::string startStateLabel = "_begining";
-	const std::string finalStateLabel = "_final";
-	const StateType firstStartState = first.getInitialState();
-	const StateType firstEndState = *std::begin(first.getFinalStates());
-	const StateType secondStartState = second.getInitialState();
-	const StateType secondEndState = *std::begin(second.getFinalStates());
+	const StateType startState = 0;
+	const StateType finalState = 1;
+	const StateType firstStartState = first.getInitialState() + firstOffset;
+	const StateType firstEndState = *std::begin(first.getFinalStates()) + firstOffset;
+	const StateType secondStartState = second.getInitialState() + secondOffset;
+	const StateType secondEndState = *std::begin(second.getFinalStates()) + secondOffset;
 
-	Automata::NFABuilder<std::string> builder;
+	Automata::NFABuilder<StateType> builder;
 
-	builder.addTransition(startStateLabel, Epsilon, firstPrefix + std::to_string(firstStartState));
-	copyTransitions(builder, first, firstPrefix);
-	builder.addTransition(firstPrefix + std::to_string(firstEndState), Epsilon, finalStateLabel);
+	builder.addTransition(startState, EpsilonId, firstStartState);
+	copyTransitions(builder, first, firstOffset);
+	builder.addTransition(firstEndState, EpsilonId, finalState);
 
-	builder.addTransition(startStateLabel, Epsilon, secondPrefix + std::to_string(secondStartState));
-	copyTransitions(builder, second, secondPrefix);
-	builder.addTransition(secondPrefix + std::to_string(secondEndState), Epsilon, finalStateLabel);
+	builder.addTransition(startState, EpsilonId, secondStartState);
+	copyTransitions(builder, second, secondOffset);
+	builder.addTransition(secondEndState, EpsilonId, finalState);
 
-	builder.setInitialStateLabel(startStateLabel);
-	builder.addFinalStateLabel(finalStateLabel);
+	builder.setInitialStateLabel(startState);
+	builder.addFinalStateLabel(finalState);
 
 	return builder.build();
 }
 
 Automata::NFA Kleene::apply(const Automata::NFA& nfa)
 {
-	const std::string startStateLabel = "_begining";
-	const std::string finalStateLabel = "_final";
-	const StateType nfaStartState = nfa.getInitialState();
-	const StateType nfaEndState = *std::begin(nfa.getFinalStates());
+	const StateType offset = 2;
 
-	NFABuilder<std::string> builder;
+	const StateType startState = 0;
+	const StateType finalState = 1;
+	const StateType nfaStartState = nfa.getInitialState() + offset;
+	const StateType nfaEndState = *std::begin(nfa.getFinalStates()) + offset;
 
-	copyTransitions(builder, nfa);
+	NFABuilder<StateType> builder;
 
-	builder.addTransition(startStateLabel, Epsilon, std::to_string(nfaStartState));
-	builder.addTransition(startStateLabel, Epsilon, finalStateLabel);
-	builder.addTransition(std::to_string(nfaEndState), Epsilon, finalStateLabel);
-	builder.addTransition(std::to_string(nfaEndState), Epsilon, std::to_string(nfaStartState));
+	copyTransitions(builder, nfa, offset);
 
-	builder.setInitialStateLabel(startStateLabel);
-	builder.addFinalStateLabel(finalStateLabel);
+	builder.addTransition(startState, EpsilonId, nfaStartState);
+	builder.addTransition(startState, EpsilonId, finalState);
+	builder.addTransition(nfaEndState, EpsilonId, finalState);
+	builder.addTransition(nfaEndState, EpsilonId, nfaStartState);
+
+	builder.setInitialStateLabel(startState);
+	builder.addFinalStateLabel(finalState);
 
 	return builder.build();
 }
 
-void copyTransitions(Automata::NFABuilder<std::string>& builder, const NFA& nfa, const std::string& prefix)
+Automata::NFA Reverse::apply(const Automata::NFA& nfa)
+{
+	const StateType offset = 1;
+	const StateType startState = 0;
+
+	NFABuilder<StateType> builder;
+
+	for(const auto& stateId: nfa)
+		for(const auto& p: nfa.getTransitions(stateId))
+		{
+			const SymbolIdType symbol = SymbolTable::intern(p.first);
+			for(const auto& endStateId: p.second)
+				builder.addTransition(endStateId + offset, symbol, stateId + offset);
+		}
+	for(const auto& finalState: nfa.getFinalStates())
+		builder.addTransition(startState, EpsilonId, finalState + offset);
+
+	builder.setInitialStateLabel(startState);
+	builder.addFinalStateLabel(nfa.getInitialState() + offset);
+
+	return builder.build();
+}
+
+void copyTransitions(Automata::NFABuilder<StateType>& builder, const NFA& nfa, const StateType& offset)
 {
 	for(const auto& stateId: nfa)
 	{
-		const std::string startStateLabel = prefix + std::to_string(stateId);
 		for(const auto& p: nfa.getTransitions(stateId))
 		{
-			const auto symbol = p.first;
-			const auto transition = p.second;
-			for(const auto& endStateId: transition)
-			{
-				const std::string endStateLabel = prefix + std::to_string(endStateId);
-				builder.addTransition(startStateLabel, symbol, endStateLabel);
-			}
+			const SymbolIdType symbol = SymbolTable::intern(p.first);
+			for(const auto& endStateId: p.second)
+				builder.addTransition(stateId + offset, symbol, endStateId + offset);
 		}
 	}
 }
 
+// ThompsonArena
+ThompsonArena::Fragment ThompsonArena::symbol(const SymbolIdType& symbol)
+{
+	const StateType start = addState();
+	const size_t edge = addEdge(start, symbol);
+	return {start, edge, edge};
+}
+
+ThompsonArena::Fragment ThompsonArena::concatenation(const Fragment& first, const Fragment& second)
+{
+	patch(first, second.start);
+	return {first.start, second.danglingHead, second.danglingTail};
+}
+
+ThompsonArena::Fragment ThompsonArena::alternative(const Fragment& first, const Fragment& second)
+{
+	const StateType start = addState();
+	addEdge(start, EpsilonId, first.start);
+	addEdge(start, EpsilonId, second.start);
+	_edges[first.danglingTail].nextDangling = second.danglingHead;
+	return {start, first.danglingHead, second.danglingTail};
+}
+
+ThompsonArena::Fragment ThompsonArena::kleene(const Fragment& fragment)
+{
+	const StateType start = addState();
+	addEdge(start, EpsilonId, fragment.start);
+	patch(fragment, start);
+	const size_t edge = addEdge(start, EpsilonId);
+	return {start, edge, edge};
+}
+
+Automata::NFA ThompsonArena::build(const Fragment& fragment)
+{
+	const StateType finalState = addState();
+	patch(fragment, finalState);
+
+	TransitionTable transitionTable;
+	for(StateType state = 0; state < _numberOfStates; state++)
+		transitionTable.addState();
+	for(const auto& edge: _edges)
+	{
+		transitionTable.addSymbol(edge.symbol);
+		transitionTable.addTransition(edge.source, edge.symbol, edge.target);
+	}
+
+	return NFA(transitionTable, fragment.start, {finalState});
+}
+
+size_t ThompsonArena::addEdge(const StateType& source, const SymbolIdType& symbol, const StateType& target)
+{
+	_edges.push_back({source, symbol, target, _edges.size()});
+	return _edges.size() - 1;
+}
+
+void ThompsonArena::patch(const Fragment& fragment, const StateType& target)
+{
+	// Lists end with an edge pointing at itself
+	size_t edge = fragment.danglingHead;
+	while(true)
+	{
+		_edges[edge].target = target;
+		if(edge == fragment.danglingTail)
+			break;
+		edge = _edges[edge].nextDangling;
+	}
+}
+
 Automata::NFA Thompson::apply(const std::string& postfix)
 {
-	std::stack<NFA> output;
+	ThompsonArena arena;
+	std::stack<ThompsonArena::Fragment> output;
 
 	for(const auto& c: postfix)
 	{
 		if(isConcatenationOperator(c))
 		{
-			const NFA b = output.top(); output.pop();
-			const NFA a = output.top(); output.pop();
-			output.push(Concatenation::apply(a, b));
+			const auto b = output.top(); output.pop();
+			const auto a = output.top(); output.pop();
+			output.push(arena.concatenation(a, b));
 		}
 		else if(isAlternativeOperator(c))
 		{
-			const NFA b = output.top(); output.pop();
-			const NFA a = output.top(); output.pop();
-			output.push(Alternative::apply(a, b));
+			const auto b = output.top(); output.pop();
+			const auto a = output.top(); output.pop();
+			output.push(arena.alternative(a, b));
 		}
 		else if(isKleeneOperator(c))
 		{
-			const NFA a = output.top(); output.pop();
-			output.push(Kleene::apply(a));
+			const auto a = output.top(); output.pop();
+			output.push(arena.kleene(a));
 		}
 		else
 		{
-			output.push(Trivial::apply(std::string(1, c)));
+			output.push(arena.symbol(static_cast<unsigned char>(c)));
 		}
 	}
 
-	return output.top();
+	return arena.build(output.top());
+}
+
+Automata::NFA Thompson::apply(const RegexAST& ast)
+{
+	using Fragment = ThompsonArena::Fragment;
+	ThompsonArena arena;
+
+	// Shared subtrees need a fragment of their own for every use
+	const Fragment fragment = ast.evaluate<Fragment>([&arena](const RegexAST::Node& node, const Fragment* left, const Fragment* right)
+	{
+		switch(node.kind)
+		{
+		case RegexAST::Kind::Concatenation: return arena.concatenation(*left, *right);
+		case RegexAST::Kind::Alternative: return arena.alternative(*left, *right);
+		case RegexAST::Kind::Kleene: return arena.kleene(*left);
+		default: return arena.symbol(node.symbol);
+		}
+	});
+
+	return arena.build(fragment);
 }
 
 } /* namespace Automata */
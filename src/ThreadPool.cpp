@@ -0,0 +1,91 @@
+#include "ThreadPool.h"
+
+namespace Automata {
+
+ThreadPool::ThreadPool(const size_t& numberOfThreads)
+:_workers(), _task(nullptr), _numberOfTasks(0), _nextTask(0), _busyWorkers(0), _generation(0), _stopping(false), _error()
+{
+	// The thread calling run is one of the threads
+	for(size_t i = 1; i < numberOfThreads; i++)
+		_workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+	for(auto& worker: _workers)
+		worker.join();
+}
+
+void ThreadPool::run(const size_t& numberOfTasks, const std::function<void(size_t)>& task)
+{
+	std::lock_guard<std::mutex> runLock(_runMutex);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		_numberOfTasks = numberOfTasks;
+		_nextTask = 0;
+		_busyWorkers = _workers.size();
+		_error = nullptr;
+		_generation++;
+	}
+	_wake.notify_all();
+
+	runTasks();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this]{ return _busyWorkers == 0; });
+	_task = nullptr;
+	if(_error)
+		std::rethrow_exception(_error);
+}
+
+size_t ThreadPool::defaultNumberOfThreads()
+{
+	const size_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+void ThreadPool::work()
+{
+	size_t generation = 0;
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this, &generation]{ return _stopping || _generation != generation; });
+			if(_stopping)
+				return;
+			generation = _generation;
+		}
+
+		runTasks();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if(--_busyWorkers == 0)
+			_done.notify_one();
+	}
+}
+
+void ThreadPool::runTasks()
+{
+	for(size_t task = _nextTask++; task < _numberOfTasks; task = _nextTask++)
+	{
+		try
+		{
+			(*_task)(task);
+		}
+		catch(...)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if(!_error)
+				_error = std::current_exception();
+		}
+	}
+}
+
+} /* namespace Automata */
@@ -3,13 +3,13 @@
 namespace Automata {
 
 TransitionTable::TransitionTable()
-:_table(), _symbols({Epsilon})
+:_table(), _symbols({Epsilon}), _columnOf(EpsilonId + 1, NoColumn), _columnSymbols({EpsilonId})
 {
-	_symbolsMapping.insert(std::make_pair(Epsilon, 0));
+	_columnOf[EpsilonId] = 0;
 }
 
 TransitionTable::TransitionTable(const TransitionTable& other)
-:_table(other._table), _symbols(other._symbols), _symbolsMapping(other._symbolsMapping)
+:_table(other._table), _symbols(other._symbols), _columnOf(other._columnOf), _columnSymbols(other._columnSymbols)
 {
 }
 
@@ -22,44 +22,52 @@ TransitionTable& TransitionTable::operator=(TransitionTable other)
 
 StateType TransitionTable::addState()
 {
-	_table.emplace_back();
-	for(size_t i = 0; i < _symbols.size(); i++)
-		_table.back().emplace_back();
+	_table.emplace_back(_columnSymbols.size());
 	return StateType(_table.size()-1);
 }
 
 void TransitionTable::addSymbol(const SymbolType& symbol)
 {
-	if(symbol.empty())
-		throw std::invalid_argument("Empty symbol is not valid");
+	addSymbol(SymbolTable::intern(symbol));
+}
 
-	if(_symbols.find(symbol) == std::end(_symbols))
-	{
-		_symbols.insert(symbol);
-		_symbolsMapping.insert(std::make_pair(symbol, _symbolsMapping.size()));
-		for(auto& row: _table)
-			row.emplace_back();
-	}
+void TransitionTable::addSymbol(const SymbolIdType& symbol)
+{
+	if(isValidSymbol(symbol))
+		return;
+
+	if(symbol >= _columnOf.size())
+		_columnOf.resize(symbol + 1, NoColumn);
+	_columnOf[symbol] = _columnSymbols.size();
+	_columnSymbols.push_back(symbol);
+	_symbols.insert(SymbolTable::getSymbol(symbol));
+	for(auto& row: _table)
+		row.emplace_back();
 }
 
 void TransitionTable::addTransition(const StateType& start, const SymbolType& symbol, const StateType& end)
+{
+	SymbolIdType id;
+	if(!SymbolTable::find(symbol, id))
+		throw std::invalid_argument("Invalid symbol");
+	addTransition(start, id, end);
+}
+
+void TransitionTable::addTransition(const StateType& start, const SymbolIdType& symbol, const StateType& end)
 {
 	if(!isValidState(start) || !isValidState(end))
 		throw std::invalid_argument("Invalid state");
 	if(!isValidSymbol(symbol))
 		throw std::invalid_argument("Invalid symbol");
-	const size_t column = _symbolsMapping[symbol];
-	_table.at(start).at(column).insert(end);
+	_table[start][_columnOf[symbol]].insert(end);
 }
 
 const StateSetType& TransitionTable::getTransition(const StateType& start, const SymbolType& symbol) const
 {
-	if(!isValidState(start))
-		throw std::invalid_argument("Invalid state");
-	if(!isValidSymbol(symbol))
+	SymbolIdType id;
+	if(!SymbolTable::find(symbol, id))
 		throw std::invalid_argument("Invalid symbol");
-	const size_t column = _symbolsMapping.find(symbol)->second;
-	return _table.at(start).at(column);
+	return getTransition(start, id);
 }
 
 StateSetType& TransitionTable::getTransition(const StateType& start, const SymbolType& symbol)
@@ -67,6 +75,15 @@ StateSetType& TransitionTable::getTransition(const StateType& start, const Symbo
 	return const_cast<StateSetType&>(static_cast<const TransitionTable&>(*this).getTransition(start, symbol));
 }
 
+const StateSetType& TransitionTable::getTransition(const StateType& start, const SymbolIdType& symbol) const
+{
+	if(!isValidState(start))
+		throw std::invalid_argument("Invalid state");
+	if(!isValidSymbol(symbol))
+		throw std::invalid_argument("Invalid symbol");
+	return _table[start][_columnOf[symbol]];
+}
+
 bool TransitionTable::isValidState(const StateType& state) const
 {
 	return 0 <= state && state < _table.size();
@@ -74,7 +91,18 @@ bool TransitionTable::isValidState(const StateType& state) const
 
 bool TransitionTable::isValidSymbol(const SymbolType& symbol) const
 {
-	return _symbols.find(symbol) != std::end(_symbols);
+	SymbolIdType id;
+	return SymbolTable::find(symbol, id) && isValidSymbol(id);
+}
+
+bool TransitionTable::isValidSymbol(const SymbolIdType& symbol) const
+{
+	return symbol < _columnOf.size() && _columnOf[symbol] != NoColumn;
+}
+
+size_t TransitionTable::getNumberOfStates() const
+{
+	return _table.size();
 }
 
 TransitionTable::TransitionIteratorTag TransitionTable::getTransitions(const StateType& state) const
@@ -190,13 +218,9 @@ std::ostream& operator<<(std::ostream& os, const TransitionTable& tt)
 		}
 	}
 
-	std::map<size_t, SymbolType> symbolMappingInverse;
-	for(const auto& p: tt._symbolsMapping)
-		symbolMappingInverse[p.second] = p.first;
-
-	for(const auto& p: symbolMappingInverse)
+	for(const auto& symbol: tt._columnSymbols)
 	{
-		os << std::setw(maxStringLength) << std::setfill(' ') << p.second;
+		os << std::setw(maxStringLength) << std::setfill(' ') << SymbolTable::getSymbol(symbol);
 	}
 	os << std::endl;
 
@@ -218,7 +242,8 @@ void swap(TransitionTable& lhs, TransitionTable& rhs)
 {
 	std::swap(lhs._table, rhs._table);
 	std::swap(lhs._symbols, rhs._symbols);
-	std::swap(lhs._symbolsMapping, rhs._symbolsMapping);
+	std::swap(lhs._columnOf, rhs._columnOf);
+	std::swap(lhs._columnSymbols, rhs._columnSymbols);
 }
 
 TransitionTable::StateIterator begin(const TransitionTable& transitionTable)
@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BatchMatcher.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+TEST(BatchMatcher, agreesWithSingleRuns)
+{
+	const DenseDFA dfa = compile("(a|b)*abb|c(ab)*");
+	const BatchMatcher matcher(dfa);
+
+	// Mixed lengths keep lanes finishing at different rounds
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < 1000; i++)
+	{
+		std::string input;
+		for(size_t j = 0; j < (i * 7) % 23; j++)
+			input += "abc"[(i + j * j) % 3 == 2 && j > 0 ? 0 : (i >> j) % 2];
+		if(i % 5 == 0)
+			input += "abb";
+		inputs.push_back(input);
+	}
+
+	const std::vector<std::uint64_t> accepted = matcher.run(inputs);
+	ASSERT_EQ((inputs.size() + 63) / 64, accepted.size());
+	size_t numberOfAccepted = 0;
+	for(size_t i = 0; i < inputs.size(); i++)
+	{
+		ASSERT_EQ(dfa.matches(inputs[i].data(), inputs[i].size()), BatchMatcher::isAccepted(accepted, i)) << inputs[i];
+		numberOfAccepted += BatchMatcher::isAccepted(accepted, i);
+	}
+	ASSERT_GT(numberOfAccepted, 0u);
+}
+
+TEST(BatchMatcher, fewerInputsThanLanes)
+{
+	const DenseDFA dfa = compile("a*");
+	const BatchMatcher matcher(dfa);
+
+	const std::vector<std::uint64_t> accepted = matcher.run({"", "aaa", "ab", "b"});
+	ASSERT_EQ(1u, accepted.size());
+	ASSERT_EQ(0x3u, accepted[0]);
+
+	ASSERT_TRUE(matcher.run(std::vector<std::string>()).empty());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
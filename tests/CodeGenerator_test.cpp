@@ -0,0 +1,46 @@
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "CodeGenerator.h"
+#include "TestHelpers.h"
+#include "endsWithAbbSwitch.h"
+#include "endsWithAbbTable.h"
+#include "CodeGeneratorRules.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+TEST(CodeGenerator, generatedMatchersAgreeWithDenseDFA)
+{
+	const DenseDFA dfa = compile("(a|b)*abb");
+	TestHelpers::agreesWithDenseDFA(dfa, "abc", [](const std::string& input){ return endsWithAbbSwitch(input); }, 12);
+	TestHelpers::agreesWithDenseDFA(dfa, "abc", [](const std::string& input){ return endsWithAbbTable(input); }, 12);
+}
+
+TEST(CodeGenerator, regexCommentIsEscaped)
+{
+	std::ostringstream oss;
+	CodeGenerator::emitHeader({{"trailing", "a\\", compile("a")}, {"control", "\"b\"\n", compile("b")}}, oss);
+
+	const std::string header = oss.str();
+	ASSERT_NE(std::string::npos, header.find("// \"a\\\\\"\n"));
+	ASSERT_NE(std::string::npos, header.find("// \"\\\"b\\\"\\x0a\"\n"));
+	ASSERT_EQ(std::string::npos, header.find("\\\n"));
+}
+
+TEST(CodeGenerator, rulesFile)
+{
+	ASSERT_TRUE(identifier("a_1"));
+	ASSERT_TRUE(identifier("_"));
+	ASSERT_FALSE(identifier("1a"));
+	ASSERT_FALSE(identifier(""));
+	ASSERT_TRUE(number("120"));
+	ASSERT_FALSE(number("12a"));
+	ASSERT_TRUE(empty(""));
+	ASSERT_FALSE(empty("a"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "DFASearcher.h"
+#include "Thompson.h"
+
+using namespace Automata;
+
+static std::vector<std::pair<size_t, size_t>> findAll(const std::string& regex, const std::string& input)
+{
+	const RegexAST ast = RegexParser::parse(regex);
+	const DFASearcher searcher(Thompson::apply(ast), Prefilter(ast));
+
+	std::vector<std::pair<size_t, size_t>> matches;
+	for(const auto& match: searcher.findAll(input))
+		matches.emplace_back(match.begin, match.end);
+	return matches;
+}
+
+using Matches = std::vector<std::pair<size_t, size_t>>;
+
+TEST(DFASearcher, findFirst)
+{
+	const DFASearcher searcher(Thompson::apply(RegexParser::parse("(a|b)*abb")));
+	Match match;
+
+	ASSERT_TRUE(searcher.findFirst("xxbabbaabbx", match));
+	ASSERT_EQ(2u, match.begin);
+	ASSERT_EQ(10u, match.end);
+
+	ASSERT_TRUE(searcher.findFirst("xxbabbaabbx", match, 6));
+	ASSERT_EQ(6u, match.begin);
+	ASSERT_EQ(10u, match.end);
+
+	ASSERT_FALSE(searcher.findFirst("xxbabbaabbx", match, 8));
+	ASSERT_FALSE(searcher.findFirst("", match));
+}
+
+TEST(DFASearcher, findAllNonOverlapping)
+{
+	ASSERT_EQ((Matches{{0, 3}, {4, 7}}), findAll("abc", "abcxabc"));
+	ASSERT_EQ((Matches{{0, 2}, {2, 4}}), findAll("aa", "aaaaa"));
+	ASSERT_EQ((Matches{{1, 4}, {6, 10}}), findAll("a(b|c)*d", "xabdxxacbd"));
+	ASSERT_EQ((Matches{}), findAll("abc", "ababab"));
+}
+
+TEST(DFASearcher, leftmostLongest)
+{
+	// The leftmost start wins even when another match ends first, then the longest end
+	ASSERT_EQ((Matches{{0, 3}}), findAll("abc|b", "abc"));
+	ASSERT_EQ((Matches{{0, 3}}), findAll("a*a", "aaa"));
+	ASSERT_EQ((Matches{{0, 3}, {3, 3}}), findAll("a*", "aaa"));
+	ASSERT_EQ((Matches{{0, 4}, {4, 4}}), findAll("(a|b)*", "abab"));
+	ASSERT_EQ((Matches{{0, 4}}), findAll("ab*", "abbb"));
+	ASSERT_EQ((Matches{{0, 1}, {1, 2}}), findAll("a|ab*c", "aab"));
+}
+
+TEST(DFASearcher, longScansAreNotRepeated)
+{
+	// Every a is a match, yet the DFA stays alive to the end of the input looking for a c
+	const DFASearcher searcher(Thompson::apply(RegexParser::parse("a|a.a*.c")));
+	const std::string input(200000, 'a');
+
+	ASSERT_EQ(input.size(), searcher.count(input));
+	ASSERT_EQ((Matches{{0, 5}, {5, 6}}), findAll("a|a.a*.c", "aaaaca"));
+}
+
+TEST(DFASearcher, emptyMatches)
+{
+	ASSERT_EQ((Matches{{0, 0}, {1, 1}, {2, 2}}), findAll("a*", "bb"));
+	ASSERT_EQ((Matches{{0, 0}}), findAll("#", ""));
+}
+
+TEST(DFASearcher, count)
+{
+	const RegexAST ast = RegexParser::parse("ab(c|d)");
+	const DFASearcher searcher(Thompson::apply(ast), Prefilter(ast));
+
+	ASSERT_EQ(3u, searcher.count("abcabdxxabcab"));
+	ASSERT_EQ(0u, searcher.count("acbd"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -66,6 +66,25 @@ TEST(DFARunner, simple2)
 
 }
 
+TEST(DenseDFA, unknownBytesGoToDeadState)
+{
+	DFABuilder<int> builder;
+	builder.addTransition(0, "a", 1);
+	builder.addTransition(1, "a", 1);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(1);
+
+	const DenseDFA dense(builder.build()); // a+
+
+	ASSERT_EQ(3u, dense.getNumberOfStates());
+	ASSERT_FALSE(dense.isAccepting(dense.getDeadState()));
+	ASSERT_EQ(dense.getDeadState(), dense.next(dense.getInitialState(), 'b'));
+	ASSERT_EQ(dense.getDeadState(), dense.next(dense.getDeadState(), 'a'));
+	ASSERT_TRUE(dense.matches("aaa", 3));
+	ASSERT_FALSE(dense.matches("aab", 3));
+	ASSERT_FALSE(dense.matches("a\0a", 3));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); 
     return RUN_ALL_TESTS();
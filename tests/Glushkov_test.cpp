@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "Glushkov.h"
+#include "Thompson.h"
+#include "Powerset.h"
+#include "SimpleAlgorithm.h"
+
+using namespace Automata;
+
+TEST(GlushkovConstruction, onePlusPositionsStates)
+{
+	const NFA nfa = Glushkov::apply(ShuntingYard::SimpleAlgorithm::apply("(a|b)*.a.b.b"));
+
+	ASSERT_EQ(6u, nfa.getNumberOfStates());
+	for(const auto& state: nfa)
+		ASSERT_TRUE(nfa.move(state, Epsilon).empty());
+
+	NFARunner runner(nfa);
+	ASSERT_TRUE(runner.run("abb"));
+	ASSERT_TRUE(runner.run("babb"));
+	ASSERT_FALSE(runner.run("ab"));
+	ASSERT_FALSE(runner.run(""));
+}
+
+TEST(GlushkovConstruction, epsilonAndNullable)
+{
+	NFARunner starRunner(Glushkov::apply("a*"));
+	ASSERT_TRUE(starRunner.run(""));
+	ASSERT_TRUE(starRunner.run("aaa"));
+	ASSERT_FALSE(starRunner.run("b"));
+
+	NFARunner epsilonRunner(Glushkov::apply("a#|"));
+	ASSERT_TRUE(epsilonRunner.run(""));
+	ASSERT_TRUE(epsilonRunner.run("a"));
+	ASSERT_FALSE(epsilonRunner.run("aa"));
+}
+
+TEST(GlushkovConstruction, agreesWithThompson)
+{
+	const std::vector<std::string> expressions({"a.(a|b)*.b", "(a.a|b)*.(a|b.b)*", "(a*|b*).c", "f.e.d.e.r.i.c.o"});
+	const std::vector<std::string> inputs({"", "a", "ab", "aab", "abab", "bb", "aabb", "c", "ac", "bbc", "federico"});
+	for(const auto& expression: expressions)
+	{
+		const std::string postfix = ShuntingYard::SimpleAlgorithm::apply(expression);
+		NFARunner thompson(Thompson::apply(postfix));
+		NFARunner glushkov(Glushkov::apply(postfix));
+		DFARunner determinized(Powerset::apply(Glushkov::apply(postfix)));
+		for(const auto& input: inputs)
+		{
+			ASSERT_EQ(thompson.run(input), glushkov.run(input)) << expression << " " << input;
+			ASSERT_EQ(thompson.run(input), determinized.run(input)) << expression << " " << input;
+		}
+	}
+}
+
+TEST(GlushkovConstruction, fromRegexAST)
+{
+	const NFA nfa = Glushkov::apply(RegexParser::parse("(a|b)*abb|#"));
+	NFARunner runner(nfa);
+
+	ASSERT_EQ(6u, nfa.getNumberOfStates());
+	ASSERT_TRUE(runner.run("abb"));
+	ASSERT_TRUE(runner.run(""));
+	ASSERT_FALSE(runner.run("ab"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
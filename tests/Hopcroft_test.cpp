@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "Hopcroft.h"
 #include "DFA.h"
+#include "ThreadPool.h"
 
 using namespace Automata;
 
@@ -86,6 +87,82 @@ TEST(Hopcroft, allABStringStartingWithB)
 	ASSERT_FALSE(dfaRunner.run("abbaaba"));
 }
 
+TEST(Hopcroft, mergesEquivalentStates)
+{
+	// (a|b)*.a.b.b with redundant copies of the start state
+	DFABuilder<int> builder;
+	builder.addTransition(0, "a", 1);
+	builder.addTransition(0, "b", 2);
+	builder.addTransition(1, "a", 1);
+	builder.addTransition(1, "b", 3);
+	builder.addTransition(2, "a", 1);
+	builder.addTransition(2, "b", 2);
+	builder.addTransition(3, "a", 1);
+	builder.addTransition(3, "b", 4);
+	builder.addTransition(4, "a", 1);
+	builder.addTransition(4, "b", 2);
+	builder.addTransition(5, "a", 5);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(4);
+	const DFA minDfa = Hopcroft::apply(builder.build());
+
+	ASSERT_EQ(4u, minDfa.getNumberOfStates());
+	ASSERT_EQ(0u, minDfa.getInitialState());
+
+	DFARunner minDfaRunner(minDfa);
+	ASSERT_TRUE(minDfaRunner.run("abb"));
+	ASSERT_TRUE(minDfaRunner.run("babb"));
+	ASSERT_TRUE(minDfaRunner.run("abbabb"));
+	ASSERT_FALSE(minDfaRunner.run("abba"));
+	ASSERT_FALSE(minDfaRunner.run(""));
+}
+
+TEST(Hopcroft, partialTransitionFunction)
+{
+	// a.b|c.b, missing transitions lead nowhere
+	DFABuilder<int> builder;
+	builder.addTransition(0, "a", 1);
+	builder.addTransition(0, "c", 2);
+	builder.addTransition(1, "b", 3);
+	builder.addTransition(2, "b", 4);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(3);
+	builder.addFinalStateLabel(4);
+	const DFA minDfa = Hopcroft::apply(builder.build());
+
+	ASSERT_EQ(3u, minDfa.getNumberOfStates());
+
+	DFARunner minDfaRunner(minDfa);
+	ASSERT_TRUE(minDfaRunner.run("ab"));
+	ASSERT_TRUE(minDfaRunner.run("cb"));
+	ASSERT_FALSE(minDfaRunner.run("bb"));
+	ASSERT_FALSE(minDfaRunner.run("a"));
+	ASSERT_FALSE(minDfaRunner.run("abb"));
+}
+
+TEST(Hopcroft, parallelMatchesSequential)
+{
+	// Last three symbols are a.b.c over {a, b, c}, plus a state with a partial transition function
+	DFABuilder<int> builder;
+	const std::string symbols = "abc";
+	for(int state = 0; state < 27; state++)
+		for(size_t symbol = 0; symbol < symbols.size(); symbol++)
+			builder.addTransition(state, std::string(1, symbols[symbol]), (state * 3 + static_cast<int>(symbol)) % 27);
+	builder.addTransition(27, "a", 0);
+	builder.addTransition(5, "d", 27);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(5);
+	const DFA dfa = builder.build();
+
+	const DFA sequential = Hopcroft::apply(dfa);
+	ThreadPool pool(4);
+	const DFA parallel = Hopcroft::applyParallel(dfa, pool);
+
+	// Four states track the a.b.c suffix, the fifth is only entered through d
+	ASSERT_EQ(to_string(sequential), to_string(parallel));
+	ASSERT_EQ(5u, parallel.getNumberOfStates());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); 
     return RUN_ALL_TESTS();
@@ -0,0 +1,50 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "JITMatcher.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+static void agreesWithDenseDFA(const DenseDFA& dfa, const std::string& alphabet)
+{
+	const JITMatcher matcher(dfa);
+#if defined(__x86_64__) && defined(__linux__)
+	ASSERT_TRUE(matcher.isCompiled());
+#endif
+
+	TestHelpers::agreesWithDenseDFA(dfa, alphabet, [&matcher](const std::string& input){ return matcher.matches(input); }, 16, 3000);
+}
+
+TEST(JITMatcher, compareChains)
+{
+	agreesWithDenseDFA(compile("(a|b)*abb"), "abc");
+	agreesWithDenseDFA(compile("(0|1|2|3)(0|1|2|3)*x"), "0123x4");
+	agreesWithDenseDFA(compile("#"), "ab");
+}
+
+TEST(JITMatcher, jumpTables)
+{
+	// Every letter is its own range, too many for a compare chain
+	agreesWithDenseDFA(compile("(a|c|e|g|i|k|m|o|q|s)*(b|d|f|h|j|l|n|p|r|t)"), "abcdefghijklmnopqrstu");
+	agreesWithDenseDFA(compile("(a|c|e|g|i|k|m|o)*z", true), "acegikmoz\xff");
+}
+
+TEST(JITMatcher, allBytes)
+{
+	const DenseDFA dfa = compile("a.b*");
+	const JITMatcher matcher(dfa);
+	for(unsigned byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+	{
+		const std::string input = std::string("a") + static_cast<char>(byte);
+		ASSERT_EQ(byte == 'b', matcher.matches(input)) << byte;
+	}
+	ASSERT_TRUE(matcher.matches("abbbb"));
+	ASSERT_FALSE(matcher.matches(""));
+	ASSERT_FALSE(matcher.matches(std::string("ab\0", 3)));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
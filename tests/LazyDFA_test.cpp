@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "LazyDFA.h"
+#include "Thompson.h"
+#include "SimpleAlgorithm.h"
+
+using namespace Automata;
+
+TEST(LazyDFARunner, agreesWithNFARunner)
+{
+	// The full DFA of this family doubles with every (a|b)
+	const NFA nfa = Thompson::apply(ShuntingYard::SimpleAlgorithm::apply("(a|b)*.a.(a|b).(a|b).(a|b)"));
+	NFARunner nfaRunner(nfa);
+	LazyDFARunner lazyRunner(nfa);
+
+	const std::vector<std::string> inputs({"", "a", "abbb", "aaaa", "babab", "bbbb", "abbbc", "bbbbbbbbabaa", "ab"});
+	for(const auto& input: inputs)
+		ASSERT_EQ(nfaRunner.run(input), lazyRunner.run(input)) << input;
+
+	ASSERT_TRUE(lazyRunner.run("abbb"));
+	ASSERT_FALSE(lazyRunner.run("bbbb"));
+	ASSERT_EQ(0u, lazyRunner.getNumberOfFlushes());
+}
+
+TEST(LazyDFARunner, flushesWhenBudgetIsExceeded)
+{
+	const NFA nfa = Thompson::apply(ShuntingYard::SimpleAlgorithm::apply("(a|b)*.a.(a|b).(a|b).(a|b).(a|b)"));
+	NFARunner nfaRunner(nfa);
+	LazyDFARunner lazyRunner(nfa, 1);
+
+	std::string input;
+	for(int i = 0; i < 64; i++)
+	{
+		input += (i * 7 % 3) ? 'a' : 'b';
+		ASSERT_EQ(nfaRunner.run(input), lazyRunner.run(input)) << input;
+	}
+	ASSERT_GT(lazyRunner.getNumberOfFlushes(), 0u);
+}
+
+TEST(LazyDFARunner, cacheIsReusedAfterFlush)
+{
+	const NFA nfa = Thompson::apply(ShuntingYard::SimpleAlgorithm::apply("(a|b)*.a.(a|b).(a|b).(a|b).(a|b).(a|b).(a|b)"));
+	NFARunner nfaRunner(nfa);
+	LazyDFARunner lazyRunner(nfa, 4096);
+
+	std::string input;
+	unsigned seed = 1;
+	for(int i = 0; i < 20000; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		input += (seed >> 16) & 1 ? 'a' : 'b';
+	}
+	ASSERT_EQ(nfaRunner.run(input), lazyRunner.run(input));
+	const size_t flushes = lazyRunner.getNumberOfFlushes();
+	ASSERT_GT(flushes, 0u);
+	ASSERT_LT(flushes, input.size() / 100);
+	ASSERT_GT(lazyRunner.getNumberOfCachedStates(), 2u);
+	ASSERT_LE(lazyRunner.getMemoryUsage(), 4096u);
+
+	// A second pass flushes about as often, it does not degrade to a flush per byte
+	for(int pass = 0; pass < 4; pass++)
+		ASSERT_EQ(nfaRunner.run(input), lazyRunner.run(input));
+	ASSERT_LT(lazyRunner.getNumberOfFlushes(), 6 * flushes);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
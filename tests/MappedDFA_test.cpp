@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "MappedDFA.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+// Serialized image copied into 8 byte aligned storage
+static std::vector<std::uint64_t> image(const DenseDFA& dfa)
+{
+	std::ostringstream oss;
+	MappedDFA::write(dfa, oss);
+	const std::string bytes = oss.str();
+	std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+	std::copy(std::begin(bytes), std::end(bytes), reinterpret_cast<char*>(storage.data()));
+	return storage;
+}
+
+TEST(MappedDFA, sameTransitionsAsDenseDFA)
+{
+	const DenseDFA dfa = compile("(a|b)*abb");
+	const std::vector<std::uint64_t> storage = image(dfa);
+	const MappedDFA mapped(reinterpret_cast<const char*>(storage.data()), storage.size() * 8);
+
+	ASSERT_EQ(dfa.getNumberOfStates(), mapped.getNumberOfStates());
+	ASSERT_EQ(dfa.getNumberOfClasses(), mapped.getNumberOfClasses());
+	ASSERT_EQ(dfa.getInitialState(), mapped.getInitialState());
+	ASSERT_EQ(dfa.getDeadState(), mapped.getDeadState());
+	for(DenseDFA::IndexType state = 0; state < dfa.getNumberOfStates(); state++)
+	{
+		ASSERT_EQ(dfa.isAccepting(state), mapped.isAccepting(state));
+		for(size_t byte = 0; byte < DenseDFA::AlphabetSize; byte++)
+			ASSERT_EQ(dfa.next(state, byte), mapped.next(state, byte));
+	}
+
+	ASSERT_TRUE(mapped.matches("abb"));
+	ASSERT_TRUE(mapped.matches("babababb"));
+	ASSERT_FALSE(mapped.matches("abba"));
+	ASSERT_FALSE(mapped.matches(""));
+}
+
+TEST(MappedDFA, saveAndMapFile)
+{
+	const std::string path = ::testing::TempDir() + "MappedDFA_test.dfa";
+	MappedDFA::save(compile("abc(d|e)*"), path);
+
+	const MappedDFA mapped(path);
+	ASSERT_TRUE(mapped.matches("abc"));
+	ASSERT_TRUE(mapped.matches("abcdeed"));
+	ASSERT_FALSE(mapped.matches("abcf"));
+	ASSERT_FALSE(mapped.matches("ab"));
+	std::remove(path.c_str());
+}
+
+TEST(MappedDFA, rejectsCorruptImages)
+{
+	std::vector<std::uint64_t> storage = image(compile("ab*"));
+	const char* data = reinterpret_cast<const char*>(storage.data());
+	const size_t size = storage.size() * 8;
+
+	ASSERT_THROW(MappedDFA(data, 16), std::invalid_argument);
+	ASSERT_THROW(MappedDFA(data + 1, size - 1), std::invalid_argument);
+	ASSERT_THROW(MappedDFA(data, size - 8), std::invalid_argument);
+
+	std::vector<std::uint64_t> badMagic = storage;
+	reinterpret_cast<char*>(badMagic.data())[0] = 'X';
+	ASSERT_THROW(MappedDFA(reinterpret_cast<const char*>(badMagic.data()), size), std::invalid_argument);
+
+	// Last word of the table pointing past the states
+	std::vector<std::uint64_t> badTarget = storage;
+	const MappedDFA valid(data, size);
+	const size_t tableEnd = 64 + 256 + valid.getNumberOfStates() * valid.getNumberOfClasses() * 4;
+	reinterpret_cast<std::uint32_t*>(reinterpret_cast<char*>(badTarget.data()) + tableEnd)[-1] = 1000;
+	ASSERT_THROW(MappedDFA(reinterpret_cast<const char*>(badTarget.data()), size), std::invalid_argument);
+
+	ASSERT_THROW(MappedDFA("/nonexistent/file.dfa"), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -117,6 +117,31 @@ TEST(NFARunner, simple2)
 		ASSERT_FALSE(runner.run(input));
 }
 
+TEST(NFARunner, reusedAcrossRuns)
+{
+	// (a|b)*.a
+	NFABuilder<int> builder;
+	builder.addTransition(0, Epsilon, 1);
+	builder.addTransition(0, Epsilon, 3);
+	builder.addTransition(1, "a", 2);
+	builder.addTransition(1, "b", 2);
+	builder.addTransition(2, Epsilon, 0);
+	builder.addTransition(3, "a", 4);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(4);
+
+	NFARunner runner(builder.build());
+
+	for(int i = 0; i < 3; i++)
+	{
+		ASSERT_TRUE(runner.run("a"));
+		ASSERT_TRUE(runner.run("abba"));
+		ASSERT_FALSE(runner.run("ab"));
+		ASSERT_FALSE(runner.run(""));
+		ASSERT_FALSE(runner.run("a\xff" "a"));
+	}
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); 
     return RUN_ALL_TESTS();
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include "gtest/gtest.h"
+#include "ParallelMatcher.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+TEST(ThreadPool, runsEveryTaskOnce)
+{
+	ThreadPool pool(4);
+	std::vector<std::atomic<int>> counts(1000);
+	for(int round = 0; round < 3; round++)
+		pool.run(counts.size(), [&counts](size_t task){ counts[task]++; });
+
+	for(const auto& count: counts)
+		ASSERT_EQ(3, count);
+}
+
+TEST(ThreadPool, rethrowsTaskErrors)
+{
+	ThreadPool pool(3);
+	ASSERT_THROW(pool.run(10, [](size_t task){ if(task == 7) throw std::invalid_argument("task"); }), std::invalid_argument);
+	pool.run(1, [](size_t){});
+}
+
+TEST(ParallelMatcher, chunkMapFollowsEveryState)
+{
+	const DenseDFA dfa = compile("(a|b)*abb(a|b)*|c(ab)*");
+	const ParallelMatcher matcher(dfa, 2);
+
+	std::string input;
+	for(size_t i = 0; i < 1000; i++)
+		input += "abc"[(i * i + i / 7) % 3 == 2 ? 1 : (i * 5) % 2];
+
+	const auto map = matcher.mapChunk(input.data(), input.size());
+	ASSERT_EQ(dfa.getNumberOfStates(), map.size());
+	for(DenseDFA::IndexType state = 0; state < map.size(); state++)
+		ASSERT_EQ(dfa.run(input.data(), input.size(), state), map[state]) << state;
+}
+
+TEST(ParallelMatcher, fallsBackWhenPathsDoNotMerge)
+{
+	// Counting a's modulo 17 permutes the states, no two paths ever merge
+	const DenseDFA dfa = compile("(a.a.a.a.a.a.a.a.a.a.a.a.a.a.a.a.a)*");
+	const ParallelMatcher matcher(dfa, 4);
+
+	std::string input(17 * ParallelMatcher::MinimumChunkSize, 'a');
+	ASSERT_TRUE(matcher.mapChunk(input.data(), input.size()).empty());
+	ASSERT_TRUE(matcher.matches(input));
+	input.pop_back();
+	ASSERT_FALSE(matcher.matches(input));
+}
+
+TEST(ParallelMatcher, matchesLikeSequentialRun)
+{
+	const DenseDFA dfa = compile("(a|b)*abb(a|b)*");
+	const ParallelMatcher matcher(dfa, 4);
+
+	std::string input(5 * ParallelMatcher::MinimumChunkSize, 'a');
+	ASSERT_FALSE(matcher.matches(input));
+
+	input.replace(input.size() - 10, 3, "abb");
+	ASSERT_TRUE(matcher.matches(input));
+	ASSERT_EQ(dfa.run(input.data(), input.size(), dfa.getInitialState()),
+			matcher.run(input.data(), input.size(), dfa.getInitialState()));
+
+	input[ParallelMatcher::MinimumChunkSize + 1] = 'c';
+	ASSERT_FALSE(matcher.matches(input));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
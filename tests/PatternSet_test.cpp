@@ -0,0 +1,45 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "PatternSet.h"
+
+using namespace Automata;
+
+TEST(PatternSet, reportsEveryMatchingPattern)
+{
+	const PatternSet patterns({"(a|b)*abb", "a(a|b)*", "ab*", "xyz"});
+
+	ASSERT_EQ(4u, patterns.size());
+	ASSERT_EQ((PatternSetType{0, 1}), patterns.match("aabb"));
+	ASSERT_EQ((PatternSetType{1, 2}), patterns.match("abbb"));
+	ASSERT_EQ((PatternSetType{0, 1, 2}), patterns.match("abb"));
+	ASSERT_EQ((PatternSetType{0}), patterns.match("babb"));
+	ASSERT_EQ((PatternSetType{3}), patterns.match("xyz"));
+	ASSERT_EQ((PatternSetType{}), patterns.match("ba"));
+	ASSERT_EQ((PatternSetType{}), patterns.match("xyzz"));
+	ASSERT_EQ((PatternSetType{}), patterns.match(""));
+}
+
+TEST(PatternSet, equalLanguagesKeepTheirIds)
+{
+	const PatternSet patterns({"a*", "(a|#)*", "aa*"});
+
+	ASSERT_EQ((PatternSetType{0, 1}), patterns.match(""));
+	ASSERT_EQ((PatternSetType{0, 1, 2}), patterns.match("aaa"));
+}
+
+TEST(PatternSet, statesWithDifferentPatternsAreNotMerged)
+{
+	// On acceptance alone the states after a and after b would merge, leaving initial,
+	// accepting and dead states plus the extra dead state of the DenseDFA
+	const PatternSet patterns({"a", "b", "a|b"});
+	const DenseDFA& dense = patterns.getDenseDFA();
+
+	ASSERT_EQ(5u, dense.getNumberOfStates());
+	ASSERT_EQ((PatternSetType{0, 2}), patterns.match("a"));
+	ASSERT_EQ((PatternSetType{1, 2}), patterns.match("b"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
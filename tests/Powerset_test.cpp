@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "Powerset.h"
+#include "ThreadPool.h"
 
 using namespace Automata;
 
@@ -48,6 +49,51 @@ TEST(Powerset, allABstringWithABBsufix)
 	ASSERT_FALSE(dfaRunner.run("abab"));
 }
 
+TEST(Powerset, unanchoredAcceptsAnySuffixMatch)
+{
+	NFABuilder<int> builder;
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(2);
+	builder.addTransition(0, "a", 1);
+	builder.addTransition(1, "b", 2);
+
+	const DenseDFA dense(Powerset::applyUnanchored(builder.build()), true);
+	const auto matches = [&](const std::string& input){ return dense.matches(input.data(), input.size()); };
+
+	ASSERT_TRUE(matches("ab"));
+	ASSERT_TRUE(matches("aab"));
+	ASSERT_TRUE(matches("bbab"));
+	ASSERT_TRUE(matches("xyzab"));
+	ASSERT_FALSE(matches(""));
+	ASSERT_FALSE(matches("abx"));
+	ASSERT_FALSE(matches("axb"));
+}
+
+TEST(Powerset, parallelMatchesSequential)
+{
+	// (a|b|c)*a(a|b|c)(a|b|c)(a|b|c), the subset construction needs 16 states
+	NFABuilder<int> builder;
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(4);
+	for(const auto& symbol: {"a", "b", "c"})
+	{
+		builder.addTransition(0, symbol, 0);
+		for(int state = 1; state < 4; state++)
+			builder.addTransition(state, symbol, state + 1);
+	}
+	builder.addTransition(0, "a", 1);
+	const NFA nfa = builder.build();
+
+	const DFA sequential = Powerset::apply(nfa);
+	ThreadPool pool(4);
+	for(int round = 0; round < 5; round++)
+	{
+		const DFA parallel = Powerset::applyParallel(nfa, pool);
+		ASSERT_EQ(16u, parallel.getNumberOfStates());
+		ASSERT_EQ(to_string(sequential), to_string(parallel));
+	}
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); 
     return RUN_ALL_TESTS();
@@ -0,0 +1,68 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "Prefilter.h"
+
+using namespace Automata;
+
+TEST(Prefilter, requiredSuffix)
+{
+	const Prefilter prefilter(RegexParser::parse("(a|b)*abb"));
+
+	ASSERT_EQ("", prefilter.getPrefix());
+	ASSERT_EQ("abb", prefilter.getSuffix());
+	ASSERT_EQ("abb", prefilter.getFactor());
+}
+
+TEST(Prefilter, requiredPrefixAndFactor)
+{
+	const Prefilter prefilter(RegexParser::parse("ab(c|d)*xyz(e|f)*g"));
+
+	ASSERT_EQ("ab", prefilter.getPrefix());
+	ASSERT_EQ("g", prefilter.getSuffix());
+	ASSERT_EQ("xyz", prefilter.getFactor());
+}
+
+TEST(Prefilter, alternativesKeepCommonParts)
+{
+	const Prefilter prefilter(RegexParser::parse("abcx|abdx"));
+
+	ASSERT_EQ("ab", prefilter.getPrefix());
+	ASSERT_EQ("x", prefilter.getSuffix());
+	ASSERT_EQ("ab", prefilter.getFactor());
+}
+
+TEST(Prefilter, nothingRequired)
+{
+	ASSERT_TRUE(Prefilter(RegexParser::parse("(ab)*")).empty());
+	ASSERT_TRUE(Prefilter(RegexParser::parse("a|b")).empty());
+}
+
+TEST(Prefilter, mayMatch)
+{
+	const Prefilter prefilter("ab", "g", "xyz");
+	const auto mayMatch = [&](const std::string& input){ return prefilter.mayMatch(input.data(), input.size()); };
+
+	ASSERT_TRUE(mayMatch("abxyzg"));
+	ASSERT_TRUE(mayMatch("abccxyzeg"));
+	ASSERT_FALSE(mayMatch("abxyg"));
+	ASSERT_FALSE(mayMatch("bxyzg"));
+	ASSERT_FALSE(mayMatch("abxyz"));
+	ASSERT_FALSE(mayMatch("ag"));
+}
+
+TEST(Prefilter, find)
+{
+	const std::string input = "aabaabbab";
+	const char* begin = input.data();
+	const char* end = begin + input.size();
+
+	ASSERT_EQ(begin + 4, Prefilter::find(begin, end, "abb"));
+	ASSERT_EQ(end, Prefilter::find(begin, end, "bbb"));
+	ASSERT_EQ(begin, Prefilter::find(begin, end, ""));
+	ASSERT_EQ(begin + 6, Prefilter::find(begin, begin + 6, "abb"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "RegexCache.h"
+
+using namespace Automata;
+
+TEST(RegexCache, equivalentSpellingsShareAnEntry)
+{
+	RegexCache cache;
+
+	const RegexCache::DFAPointer first = cache.get("(a|b)*abb");
+	const RegexCache::DFAPointer second = cache.get("(a|b)*.a.b.b");
+	const RegexCache::DFAPointer third = cache.get("((a|b)*)*abb");
+
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(first, third);
+	ASSERT_EQ(1u, cache.size());
+	ASSERT_EQ(3u, cache.getMisses() + cache.getHits());
+	ASSERT_EQ(2u, cache.getHits());
+
+	DFARunner runner(*first);
+	ASSERT_TRUE(runner.run("babb"));
+	ASSERT_FALSE(runner.run("abab"));
+}
+
+TEST(RegexCache, evictsLeastRecentlyUsed)
+{
+	const size_t entryMemory = RegexCache::estimateMemory(RegexCache::compile(RegexParser::parse("abc"))) + 10;
+	RegexCache cache(2 * entryMemory);
+
+	const RegexCache::DFAPointer abc = cache.get("abc");
+	cache.get("abd");
+	cache.get("abc");
+	cache.get("abe");
+
+	// abd was the least recently used one
+	ASSERT_EQ(2u, cache.size());
+	ASSERT_EQ(1u, cache.getEvictions());
+	ASSERT_LE(cache.getMemoryUsage(), 2 * entryMemory);
+	ASSERT_EQ(abc, cache.get("abc"));
+	const size_t misses = cache.getMisses();
+	cache.get("abd");
+	ASSERT_EQ(misses + 1, cache.getMisses());
+
+	// Evicted DFAs stay usable by whoever holds them
+	cache.clear();
+	ASSERT_EQ(0u, cache.size());
+	ASSERT_TRUE(DFARunner(*abc).run("abc"));
+}
+
+TEST(RegexCache, entriesOverTheBudgetAreNotKept)
+{
+	RegexCache cache(1);
+
+	ASSERT_TRUE(cache.get("abc") != nullptr);
+	ASSERT_EQ(0u, cache.size());
+	ASSERT_EQ(0u, cache.getMemoryUsage());
+}
+
+TEST(RegexCache, concurrentLookups)
+{
+	RegexCache cache;
+	const std::vector<std::string> regexes({"a*b", "(ab)*", "a|b|c", "abc(d|e)*"});
+
+	std::vector<std::thread> threads;
+	for(size_t thread = 0; thread < 4; thread++)
+		threads.emplace_back([&cache, &regexes]()
+		{
+			for(size_t i = 0; i < 100; i++)
+				cache.get(regexes[i % regexes.size()]);
+		});
+	for(auto& thread: threads)
+		thread.join();
+
+	ASSERT_EQ(regexes.size(), cache.size());
+	ASSERT_EQ(400u, cache.getHits() + cache.getMisses());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include <sstream>
+#include "gtest/gtest.h"
+#include "RegexOptimizer.h"
+#include "Thompson.h"
+
+using namespace Automata;
+
+static std::string optimize(const std::string& regex)
+{
+	std::ostringstream output;
+	output << RegexOptimizer::apply(RegexParser::parse(regex));
+	return output.str();
+}
+
+TEST(RegexOptimizer, factorsCommonPrefix)
+{
+	ASSERT_EQ("abc|.", optimize("ab|ac"));
+	ASSERT_EQ("ab.cd|.", optimize("abc|abd"));
+}
+
+TEST(RegexOptimizer, factorsCommonSuffix)
+{
+	ASSERT_EQ("ab|c.", optimize("ac|bc"));
+}
+
+TEST(RegexOptimizer, removesDuplicateAlternatives)
+{
+	ASSERT_EQ("a", optimize("a|a"));
+	ASSERT_EQ("ab|", optimize("a|b|a|b"));
+}
+
+TEST(RegexOptimizer, simplifiesStarsAndEpsilon)
+{
+	ASSERT_EQ("a*", optimize("(a*)*"));
+	ASSERT_EQ("ab.", optimize("a#b"));
+	ASSERT_EQ("#", optimize("#*"));
+}
+
+TEST(RegexOptimizer, sharesIdenticalSubtrees)
+{
+	const RegexAST regex = RegexParser::parse("(a|b)*c(a|b)*");
+	const RegexAST optimized = RegexOptimizer::apply(regex);
+
+	ASSERT_LT(optimized.size(), regex.size());
+}
+
+TEST(RegexOptimizer, preservesLanguage)
+{
+	const std::string regex = "(ab|ac)*(xa|ya)|abd|ab";
+	NFARunner original(Thompson::apply(RegexParser::parse(regex)));
+	NFARunner optimized(Thompson::apply(RegexOptimizer::apply(RegexParser::parse(regex))));
+
+	for(const auto& input: {"", "ab", "abd", "xa", "ya", "abxa", "acabya", "ac", "abac", "xya", "abdd"})
+		ASSERT_EQ(original.run(input), optimized.run(input)) << input;
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "RegexParser.h"
+
+using namespace Automata;
+
+static std::string postfix(const std::string& input)
+{
+	return to_string(RegexParser::parse(input));
+}
+
+TEST(RegexParser, sameTreeAsShuntingYard)
+{
+	ASSERT_EQ("a", postfix("a"));
+	ASSERT_EQ("a", postfix("(a)"));
+	ASSERT_EQ("a**", postfix("a**"));
+	ASSERT_EQ("ab|c|", postfix("a|b|c"));
+	ASSERT_EQ("ab.c.", postfix("a.b.c"));
+	ASSERT_EQ("ab|*a.b.b.", postfix("(a|b)*.a.b.b"));
+	ASSERT_EQ("abc*|.", postfix("a.(b|c*)"));
+	ASSERT_EQ("aa.b|*abb.|*.", postfix("(a.a|b)*.(a|b.b)*"));
+	ASSERT_EQ("a#|", postfix("a|#"));
+}
+
+TEST(RegexParser, implicitConcatenation)
+{
+	ASSERT_EQ(postfix("(a|b)*.a.b.b"), postfix("(a|b)*abb"));
+	ASSERT_EQ(postfix("a.(b|c)*"), postfix("a(b|c)*"));
+	ASSERT_EQ("ab.c.", postfix("ab.c"));
+}
+
+TEST(RegexParser, childrenBeforeParents)
+{
+	const RegexAST ast = RegexParser::parse("(a|b)*c");
+	ASSERT_EQ(ast.size() - 1, ast.getRoot());
+	RegexAST::NodeIdType id = 0;
+	for(const auto& node: ast)
+	{
+		if(node.left != RegexAST::NoNode)
+		{
+			ASSERT_LT(node.left, id);
+		}
+		if(node.right != RegexAST::NoNode)
+		{
+			ASSERT_LT(node.right, id);
+		}
+		id++;
+	}
+}
+
+TEST(RegexParser, errorPositions)
+{
+	const std::vector<std::pair<std::string, size_t>> cases({{"", 0}, {"(a|b", 0}, {"a|", 2}, {"a)", 1}, {"*a", 0}, {"a.|b", 2}, {"a(()", 3}});
+	for(const auto& p: cases)
+	{
+		try
+		{
+			RegexParser::parse(p.first);
+			FAIL() << p.first;
+		}
+		catch(const RegexParseError& e)
+		{
+			ASSERT_EQ(p.second, e.getPosition()) << p.first << ": " << e.what();
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
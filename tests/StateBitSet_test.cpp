@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "StateBitSet.h"
+
+using namespace Automata;
+
+TEST(StateBitSet, insertAndContains)
+{
+	StateBitSet states(130);
+	ASSERT_TRUE(states.empty());
+
+	states.insert(0);
+	states.insert(64);
+	states.insert(129);
+
+	ASSERT_FALSE(states.empty());
+	ASSERT_TRUE(states.contains(0));
+	ASSERT_TRUE(states.contains(64));
+	ASSERT_TRUE(states.contains(129));
+	ASSERT_FALSE(states.contains(1));
+	ASSERT_EQ(3u, states.count());
+	ASSERT_EQ(StateSetType({0, 64, 129}), states.toStateSet());
+
+	states.clear();
+	ASSERT_TRUE(states.empty());
+}
+
+TEST(StateBitSet, unionEqualityAndHash)
+{
+	const StateBitSet a(100, {1, 2, 70});
+	const StateBitSet b(100, {2, 99});
+
+	StateBitSet c = a;
+	c |= b;
+	ASSERT_EQ(StateBitSet(100, {1, 2, 70, 99}), c);
+	ASSERT_NE(a, c);
+	ASSERT_TRUE(a.intersects(b));
+	ASSERT_FALSE(StateBitSet(100, {1}).intersects(b));
+	ASSERT_EQ(StateBitSet(100, {1, 2, 70}).hash(), a.hash());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
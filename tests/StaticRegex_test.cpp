@@ -0,0 +1,56 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "StaticRegex.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+static constexpr char endsWithAbb[] = "(a|b)*abb";
+static constexpr char identifier[] = "(a|b|c|_)(a|b|c|_|0|1|2)*";
+static constexpr char keywords[] = "i.f|e.l.s.e|w.h.i.l.e|#";
+static constexpr char nested[] = "((a|b).c*)*.(d|#)";
+static constexpr char deep[] = "(a|b)*a(a|b)(a|b)(a|b)";
+
+static_assert(StaticRegex<endsWithAbb>::match("babb"));
+static_assert(!StaticRegex<endsWithAbb>::match("abba"));
+static_assert(StaticRegex<endsWithAbb>::NumberOfStates == 5);
+static_assert(StaticRegex<identifier>::NumberOfClasses == 3);
+static_assert(StaticRegex<keywords>::match(""));
+static_assert(!StaticRegex<keywords>::match("els"));
+
+template <class Regex>
+static void agreesWithDenseDFA(const std::string& regex, const std::string& alphabet)
+{
+	const DenseDFA dfa = compile(regex);
+	// The runtime DFA may keep the empty subset next to its own dead state
+	ASSERT_LE(Regex::NumberOfStates, dfa.getNumberOfStates()) << regex;
+
+	TestHelpers::agreesWithDenseDFA(dfa, alphabet, [](const std::string& input){ return Regex::match(input); }, 10);
+}
+
+TEST(StaticRegex, agreesWithRuntimePipeline)
+{
+	agreesWithDenseDFA<StaticRegex<endsWithAbb>>(endsWithAbb, "abc");
+	agreesWithDenseDFA<StaticRegex<identifier>>(identifier, "abc_012x");
+	agreesWithDenseDFA<StaticRegex<keywords>>(keywords, "ifelswh");
+	agreesWithDenseDFA<StaticRegex<nested>>(nested, "abcde");
+	agreesWithDenseDFA<StaticRegex<deep>>(deep, "ab");
+}
+
+TEST(StaticRegex, stepByStep)
+{
+	using Regex = StaticRegex<endsWithAbb>;
+	Regex::StateType state = Regex::InitialState;
+	for(const char c: std::string("aab"))
+		state = Regex::next(state, c);
+	ASSERT_FALSE(Regex::isAccepting(state));
+	state = Regex::next(state, 'b');
+	ASSERT_TRUE(Regex::isAccepting(state));
+	ASSERT_EQ(Regex::DeadState, Regex::next(state, 'x'));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
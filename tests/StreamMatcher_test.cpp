@@ -0,0 +1,76 @@
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "gtest/gtest.h"
+#include "StreamMatcher.h"
+#include "TestHelpers.h"
+
+using namespace Automata;
+using TestHelpers::compile;
+
+TEST(StreamMatcher, anySplitMatchesWholeInput)
+{
+	const DenseDFA dfa = compile("(a|b)*abb");
+	const std::string input = "abababbbaabb";
+
+	for(size_t split = 0; split <= input.size(); split++)
+	{
+		StreamMatcher matcher(dfa);
+		matcher.feed(input.substr(0, split));
+		matcher.feed(input.substr(split));
+		ASSERT_TRUE(matcher.finish()) << split;
+	}
+
+	StreamMatcher matcher(dfa);
+	for(const auto& byte: input.substr(0, input.size() - 1))
+		matcher.feed(&byte, 1);
+	ASSERT_FALSE(matcher.finish());
+}
+
+TEST(StreamMatcher, saveAndResume)
+{
+	const DenseDFA dfa = compile("abc(d|e)*");
+
+	StreamMatcher first(dfa);
+	first.feed("ab");
+	const StreamMatcher::IndexType saved = first.getState();
+
+	StreamMatcher second(dfa);
+	second.setState(saved);
+	second.feed("cded");
+	ASSERT_TRUE(second.finish());
+
+	first.feed("cx");
+	ASSERT_TRUE(first.isDead());
+	first.feed("de");
+	ASSERT_FALSE(first.finish());
+
+	first.reset();
+	first.feed("abcd");
+	ASSERT_TRUE(first.finish());
+
+	ASSERT_THROW(first.setState(dfa.getDeadState() + 1), std::invalid_argument);
+}
+
+TEST(StreamMatcher, fileInput)
+{
+	const DenseDFA dfa = compile("(a|b)*abb");
+	const std::string path = ::testing::TempDir() + "StreamMatcher_test.txt";
+
+	std::ofstream(path) << std::string(100000, 'a') << "bb";
+	StreamMatcher matcher(dfa);
+	matcher.feedFile(path);
+	ASSERT_TRUE(matcher.finish());
+
+	std::ofstream(path, std::ios::trunc).flush();
+	matcher.reset();
+	matcher.feedFile(path);
+	ASSERT_FALSE(matcher.finish());
+
+	ASSERT_THROW(matcher.feedFile(path + ".missing"), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "SubsetTable.h"
+#include "ConcurrentSubsetTable.h"
+
+using namespace Automata;
+
+TEST(SubsetTable, internReturnsCanonicalIds)
+{
+	SubsetTable table(70);
+
+	const auto first = table.intern(StateBitSet(70, {0, 1, 69}));
+	const auto second = table.intern(StateBitSet(70, {2}));
+	const auto again = table.intern(StateBitSet(70, {0, 1, 69}));
+
+	ASSERT_EQ(0u, first.first);
+	ASSERT_TRUE(first.second);
+	ASSERT_EQ(1u, second.first);
+	ASSERT_TRUE(second.second);
+	ASSERT_EQ(first.first, again.first);
+	ASSERT_FALSE(again.second);
+	ASSERT_EQ(2u, table.size());
+	ASSERT_EQ(StateBitSet(70, {0, 1, 69}), table.getSubset(first.first));
+	ASSERT_TRUE(table.contains(second.first, 2));
+	ASSERT_FALSE(table.contains(second.first, 0));
+}
+
+TEST(SubsetTable, manySubsets)
+{
+	SubsetTable table(200);
+	for(StateType i = 0; i < 200; i++)
+		ASSERT_EQ(i, table.intern(StateBitSet(200, {i})).first);
+	for(StateType i = 0; i < 200; i++)
+		ASSERT_EQ(i, table.intern(StateBitSet(200, {i})).first);
+	ASSERT_EQ(200u, table.size());
+	ASSERT_ANY_THROW(table.intern(StateBitSet(10)));
+}
+
+TEST(ConcurrentSubsetTable, threadsAgreeOnIds)
+{
+	ConcurrentSubsetTable table(100, 8);
+	const size_t numberOfThreads = 4;
+	std::vector<std::vector<ConcurrentSubsetTable::IdType>> ids(numberOfThreads);
+	std::vector<size_t> created(numberOfThreads, 0);
+
+	std::vector<std::thread> threads;
+	for(size_t thread = 0; thread < numberOfThreads; thread++)
+		threads.emplace_back([&, thread]()
+		{
+			for(StateType state = 0; state < 100; state++)
+			{
+				const auto id = table.intern(StateBitSet(100, {state, 99}));
+				ids[thread].push_back(id.first);
+				created[thread] += id.second;
+			}
+		});
+	for(auto& thread: threads)
+		thread.join();
+
+	ASSERT_EQ(100u, table.size());
+	ASSERT_EQ(100u, created[0] + created[1] + created[2] + created[3]);
+	for(size_t thread = 1; thread < numberOfThreads; thread++)
+		ASSERT_EQ(ids[0], ids[thread]);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
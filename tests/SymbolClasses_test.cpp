@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "SymbolClasses.h"
+
+using namespace Automata;
+
+TEST(SymbolClasses, mergesSymbolsWithSameTransitions)
+{
+	// (a|b)*.c
+	DFABuilder<int> builder;
+	builder.addTransition(0, "a", 0);
+	builder.addTransition(0, "b", 0);
+	builder.addTransition(0, "c", 1);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(1);
+	const DFA dfa = builder.build();
+
+	const SymbolClasses classes(dfa);
+
+	ASSERT_EQ(2u, classes.getNumberOfClasses());
+	ASSERT_EQ(classes.getClass("a"), classes.getClass("b"));
+	ASSERT_NE(classes.getClass("a"), classes.getClass("c"));
+	ASSERT_EQ(SymbolSetType({"a", "b"}), classes.getSymbols(classes.getClass("a")));
+	ASSERT_EQ("a", classes.getRepresentative(classes.getClass("b")));
+	ASSERT_ANY_THROW(classes.getClass("d"));
+}
+
+TEST(SymbolClasses, nfaStatesSplitClasses)
+{
+	NFABuilder<int> builder;
+	builder.addTransition(0, "a", 1);
+	builder.addTransition(0, "b", 1);
+	builder.addTransition(0, Epsilon, 2);
+	builder.addTransition(2, "b", 3);
+	builder.addTransition(2, "c", 3);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(3);
+
+	const SymbolClasses classes(builder.build());
+
+	ASSERT_EQ(3u, classes.getNumberOfClasses());
+	ASSERT_NE(classes.getClass("a"), classes.getClass("b"));
+	ASSERT_NE(classes.getClass("b"), classes.getClass("c"));
+}
+
+TEST(DenseDFA, byteClasses)
+{
+	DFABuilder<int> builder;
+	builder.addTransition(0, "a", 0);
+	builder.addTransition(0, "b", 0);
+	builder.addTransition(0, "c", 1);
+	builder.setInitialStateLabel(0);
+	builder.addFinalStateLabel(1);
+
+	const DenseDFA dense(builder.build());
+
+	// {a, b}, {c} and every other byte
+	ASSERT_EQ(3u, dense.getNumberOfClasses());
+	ASSERT_EQ(dense.getByteClasses()['a'], dense.getByteClasses()['b']);
+	ASSERT_EQ(dense.getByteClasses()['x'], dense.getByteClasses()[0]);
+	ASSERT_TRUE(dense.matches("abbac", 5));
+	ASSERT_FALSE(dense.matches("abxc", 4));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,32 @@
+#include "gtest/gtest.h"
+#include "SymbolTable.h"
+
+using namespace Automata;
+
+TEST(SymbolTable, singleBytesAreTheirOwnIds)
+{
+	ASSERT_EQ(SymbolIdType('a'), SymbolTable::intern("a"));
+	ASSERT_EQ(EpsilonId, SymbolTable::intern(Epsilon));
+	ASSERT_EQ(SymbolType("z"), SymbolTable::getSymbol('z'));
+	ASSERT_TRUE(SymbolTable::isByte(SymbolTable::intern("\xff")));
+}
+
+TEST(SymbolTable, longerSymbolsAreInterned)
+{
+	SymbolIdType id;
+	ASSERT_FALSE(SymbolTable::find("never interned", id));
+
+	const SymbolIdType keyword = SymbolTable::intern("keyword");
+	ASSERT_FALSE(SymbolTable::isByte(keyword));
+	ASSERT_EQ(keyword, SymbolTable::intern("keyword"));
+	ASSERT_NE(keyword, SymbolTable::intern("other"));
+	ASSERT_TRUE(SymbolTable::find("keyword", id));
+	ASSERT_EQ(keyword, id);
+	ASSERT_EQ(SymbolType("keyword"), SymbolTable::getSymbol(keyword));
+	ASSERT_ANY_THROW(SymbolTable::intern(""));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv); 
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,40 @@
+#ifndef TESTHELPERS_H_
+#define TESTHELPERS_H_
+
+#include <random>
+#include <string>
+#include "gtest/gtest.h"
+#include "DFA.h"
+#include "Hopcroft.h"
+#include "Powerset.h"
+#include "Thompson.h"
+
+namespace Automata {
+namespace TestHelpers {
+
+// Minimal DenseDFA of a regex, what the matchers under test are built from
+inline DenseDFA compile(const std::string& regex, const bool& unanchored = false)
+{
+	return DenseDFA(Hopcroft::apply(Powerset::apply(Thompson::apply(RegexParser::parse(regex)))), unanchored);
+}
+
+// Random inputs over the alphabet, shorter than maxLength, on which accepts has to agree with the DFA
+template <class Accepts>
+void agreesWithDenseDFA(const DenseDFA& dfa, const std::string& alphabet, Accepts accepts,
+		const size_t& maxLength = 16, const size_t& numberOfInputs = 2000)
+{
+	std::mt19937 random(3);
+	for(size_t i = 0; i < numberOfInputs; i++)
+	{
+		std::string input;
+		const size_t length = random() % maxLength;
+		for(size_t j = 0; j < length; j++)
+			input += alphabet[random() % alphabet.size()];
+		ASSERT_EQ(dfa.matches(input.data(), input.size()), accepts(input)) << input;
+	}
+}
+
+} /* namespace TestHelpers */
+} /* namespace Automata */
+
+#endif /* TESTHELPERS_H_ */
@@ -139,6 +139,17 @@ TEST(ThompsonConstruction, simple1)
 	ASSERT_FALSE(runner.run("aba"));
 }
 
+TEST(ThompsonConstruction, fromRegexAST)
+{
+	const NFA nfa = Thompson::apply(RegexParser::parse("(a|b)*abb"));
+	NFARunner runner(nfa);
+
+	ASSERT_TRUE(runner.run("abb"));
+	ASSERT_TRUE(runner.run("babb"));
+	ASSERT_FALSE(runner.run("ab"));
+	ASSERT_FALSE(runner.run("abba"));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); 
     return RUN_ALL_TESTS();
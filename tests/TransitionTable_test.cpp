@@ -53,6 +53,24 @@ TEST(TransitionTable, AddTransitionAndGetTransition)
 	ASSERT_ANY_THROW(tt.getTransition(source, "c"));
 }
 
+TEST(TransitionTable, SymbolIds)
+{
+	TransitionTable tt;
+	const auto source = tt.addState();
+	const auto end = tt.addState();
+	const Automata::SymbolIdType symbol = Automata::SymbolTable::intern("a");
+	tt.addSymbol(symbol);
+
+	ASSERT_TRUE(tt.isValidSymbol(symbol));
+	ASSERT_TRUE(tt.isValidSymbol("a"));
+	ASSERT_FALSE(tt.isValidSymbol(Automata::SymbolTable::intern("b")));
+
+	tt.addTransition(source, symbol, end);
+	ASSERT_EQ(tt.getTransition(source, "a"), StateSetType({end}));
+	ASSERT_EQ(tt.getTransition(source, symbol), StateSetType({end}));
+	ASSERT_ANY_THROW(tt.getTransition(source, Automata::SymbolTable::intern("b")));
+}
+
 TEST(TransitionTableTest, Iterator)
 {
 	TransitionTable tt;